@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef VCRTOS_COND_H
+#define VCRTOS_COND_H
+
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/list.h>
+#include <vcrtos/mutex.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct cond
+{
+    list_node_t queue; /* waiters, ordered by priority */
+    mutex_t *mutex;    /* mutex used by the current waiters */
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    void *instance;
+#endif
+} cond_t;
+
+void cond_init(void *instance, cond_t *cond);
+
+/* Atomically unlock mutex and wait, mutex is locked again on return. All
+ * concurrent waiters on a condition variable must use the same mutex */
+void cond_wait(cond_t *cond, mutex_t *mutex);
+
+/* Same as cond_wait(), returns 0 when signaled or -ETIMEDOUT, mutex is locked
+ * again in both cases. A timeout of 0 waits forever */
+int cond_wait_timed(cond_t *cond, mutex_t *mutex, uint32_t timeout);
+
+void cond_signal(cond_t *cond);
+
+void cond_broadcast(cond_t *cond);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VCRTOS_COND_H */
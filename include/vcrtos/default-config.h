@@ -42,6 +42,70 @@
 #define VCRTOS_CONFIG_THREAD_EVENT_ENABLE 0
 #endif
 
+#ifndef VCRTOS_CONFIG_THREAD_EVENT_STATS_ENABLE
+#define VCRTOS_CONFIG_THREAD_EVENT_STATS_ENABLE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE
+#define VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+#define VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_PRIORITY_BANDS
+#define VCRTOS_CONFIG_MSG_PRIORITY_BANDS 4
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+#define VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+#define VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+#define VCRTOS_CONFIG_MSG_ASYNC_ENABLE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE
+#define VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+#define VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+#define VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_FILTER_ENABLE
+#define VCRTOS_CONFIG_MSG_FILTER_ENABLE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_FILTER_SCAN_LIMIT
+#define VCRTOS_CONFIG_MSG_FILTER_SCAN_LIMIT 16
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+#define VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE 0
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_LATENCY_HIST_BUCKETS
+#define VCRTOS_CONFIG_MSG_LATENCY_HIST_BUCKETS 8
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_LATENCY_HIST_SHIFT
+#define VCRTOS_CONFIG_MSG_LATENCY_HIST_SHIFT 4
+#endif
+
+#ifndef VCRTOS_CONFIG_MSG_BUF_DEBUG
+#define VCRTOS_CONFIG_MSG_BUF_DEBUG 0
+#endif
+
 #ifndef VCRTOS_CONFIG_UTILS_UART_TSRB_ISRPIPE_SIZE
 #define VCRTOS_CONFIG_UTILS_UART_TSRB_ISRPIPE_SIZE 128
 #endif
@@ -104,6 +168,10 @@
 #define VCRTOS_CONFIG_THREAD_EVENT_LOWEST_PRIORITY (KERNEL_THREAD_PRIORITY_IDLE - 1)
 #endif
 
+#ifndef VCRTOS_CONFIG_WORK_QUEUE_ENABLE
+#define VCRTOS_CONFIG_WORK_QUEUE_ENABLE 0
+#endif
+
 #ifndef VCRTOS_CONFIG_ZTIMER_ENABLE
 #define VCRTOS_CONFIG_ZTIMER_ENABLE 0
 #endif
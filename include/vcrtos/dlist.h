@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef VCRTOS_DLIST_H
+#define VCRTOS_DLIST_H
+
+#include <vcrtos/config.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct dlist_node
+{
+    struct dlist_node *next;
+    struct dlist_node *prev;
+} dlist_node_t;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VCRTOS_DLIST_H */
@@ -18,7 +18,10 @@
 #ifndef VCRTOS_EVENT_H
 #define VCRTOS_EVENT_H
 
+#include <stdint.h>
+
 #include <vcrtos/config.h>
+#include <vcrtos/dlist.h>
 #include <vcrtos/thread.h>
 
 #ifdef __cplusplus
@@ -27,25 +30,52 @@ extern "C" {
 
 #define THREAD_FLAG_EVENT (0x1)
 
+typedef struct event event_t;
+
+typedef void (*event_handler_func_t)(event_t *event);
+
+struct event
+{
+    dlist_node_t list_node;
+    event_handler_func_t handler;
+};
+
 typedef struct
 {
-    clist_node_t list_node;
-} event_t;
+    uint32_t posts;   /* number of event_post() calls */
+    uint32_t wakeups; /* number of times the event thread was signaled */
+    uint32_t events;  /* number of events handed to the event thread */
+} event_queue_stats_t;
 
 typedef struct
 {
-    clist_node_t event_list;
+    dlist_node_t event_list;
+    unsigned int numof_events;
+    unsigned int numof_batched; /* oldest numof_events claimed by a batch */
+    uint8_t coalesce;
+#if VCRTOS_CONFIG_THREAD_EVENT_STATS_ENABLE
+    event_queue_stats_t stats;
+#endif
 #if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
     void *instance;
 #endif
 } event_queue_t;
 
+typedef struct
+{
+    event_queue_t *queue;
+} event_batch_t;
+
 void event_init(event_t *event);
 
+void event_init_handler(event_t *event, event_handler_func_t handler);
+
 void event_queue_init(void *instance, event_queue_t *queue);
 
 void event_post(event_queue_t *queue, event_t *event, thread_t *thread);
 
+/* Remove event from queue, if a batch is taken from queue it hands out one
+ * event less, so it never picks up events posted after it was taken */
 void event_cancel(event_queue_t *queue, event_t *event);
 
 event_t *event_get(event_queue_t *queue);
@@ -60,6 +90,29 @@ int event_pending(event_queue_t *queue);
 
 event_t *event_peek(event_queue_t *queue);
 
+/* When coalescing is enabled, event_post() only signals the event thread if
+ * there is no THREAD_FLAG_EVENT wakeup already pending for it */
+void event_queue_set_coalesce(event_queue_t *queue, int enable);
+
+/* Claim all queued events for batch in one go, returns number of events
+ * claimed. Claimed events stay queued until handed out, so event_pending(),
+ * event_peek() and event_get() still see them */
+unsigned event_get_batch(event_queue_t *queue, event_batch_t *batch);
+
+/* Same as event_get_batch() but block until at least one event is available */
+unsigned event_wait_batch(event_queue_t *queue, event_batch_t *batch);
+
+/* Pop and release the next event in the batch, NULL if batch is empty */
+event_t *event_batch_get(event_batch_t *batch);
+
+#if VCRTOS_CONFIG_THREAD_EVENT_STATS_ENABLE
+void event_queue_get_stats(event_queue_t *queue, event_queue_stats_t *stats);
+
+void event_queue_reset_stats(event_queue_t *queue);
+
+unsigned event_queue_events_per_wakeup(event_queue_t *queue);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef VCRTOS_MBOX_H
+#define VCRTOS_MBOX_H
+
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/cib.h>
+#include <vcrtos/list.h>
+#include <vcrtos/msg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct mbox
+{
+    list_node_t readers; /* threads waiting in get, ordered by priority */
+    list_node_t writers; /* threads waiting in put, ordered by priority */
+    cib_t cib;
+    msg_t *msg_array;
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    void *instance;
+#endif
+} mbox_t;
+
+/* queue_size must be a power of two, or 0 for a mailbox without buffer
+ * where put and get always rendezvous */
+void mbox_init(void *instance, mbox_t *mbox, msg_t *queue, unsigned int queue_size);
+
+/* Blocks while the mailbox is full, never blocks when called from ISR.
+ * Returns 0 when the message was delivered, -EAGAIN otherwise */
+int mbox_put(mbox_t *mbox, msg_t *msg);
+
+/* Returns 1 when the message was delivered, 0 otherwise */
+int mbox_try_put(mbox_t *mbox, msg_t *msg);
+
+/* A timeout of 0 waits forever. Returns 0 when the message was delivered,
+ * -ETIMEDOUT when the timeout expired or -EAGAIN when called from ISR on a
+ * full mailbox */
+int mbox_put_timeout(mbox_t *mbox, msg_t *msg, uint32_t timeout);
+
+void mbox_get(mbox_t *mbox, msg_t *msg);
+
+/* Returns 1 when a message was received, 0 otherwise */
+int mbox_try_get(mbox_t *mbox, msg_t *msg);
+
+/* A timeout of 0 waits forever. Returns 0 when a message was received or
+ * -ETIMEDOUT when the timeout expired */
+int mbox_get_timeout(mbox_t *mbox, msg_t *msg, uint32_t timeout);
+
+unsigned int mbox_avail(mbox_t *mbox);
+
+unsigned int mbox_size(mbox_t *mbox);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VCRTOS_MBOX_H */
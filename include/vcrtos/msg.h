@@ -18,8 +18,10 @@
 #ifndef VCRTOS_MSG_H
 #define VCRTOS_MSG_H
 
+#include <stddef.h>
 #include <stdint.h>
 
+#include <vcrtos/cib.h>
 #include <vcrtos/config.h>
 #include <vcrtos/kernel.h>
 #include <vcrtos/list.h>
@@ -36,12 +38,132 @@ typedef struct msg
     {
         void *ptr;
         uint32_t value;
+#if VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE
+        uint8_t data[VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE];
+#endif
     } content;
+#if VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE
+    uint16_t size; /* used bytes of content.data, 0 when only ptr or value is used */
+#endif
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    uint8_t priority; /* thread priority scale, MSG_PRIORITY_AUTO uses the sender one */
+#endif
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE || VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE
+    /* matches the reply to a msg_future_t, or with the request check to the
+     * send_receive() call, 0 for a plain msg */
+    uint16_t correlation_id;
+#endif
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+    uint8_t origin_kept; /* origin is carried by the next send instead of restamped */
+    uint32_t timestamp;  /* ZTIMER_USEC time the msg was sent */
+    uint32_t origin;     /* ZTIMER_USEC time the msg entered the processing chain */
+#endif
 #if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
     void *instance;
 #endif
 } msg_t;
 
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+/* What a send does when the queue of the target thread is full. A queued
+ * send_receive() request whose client waits for the reply is never dropped
+ * or overwritten, the send fails instead. Other msgs are discarded without
+ * looking at their content, a msg_buf_t sent to such a queue loses its
+ * reference when its msg is discarded. */
+typedef enum
+{
+    MSG_QUEUE_POLICY_BLOCK,       /* sender blocks until there is room, default */
+    MSG_QUEUE_POLICY_REJECT,      /* send fails right away */
+    MSG_QUEUE_POLICY_DROP_OLDEST, /* oldest queued msg is discarded */
+    MSG_QUEUE_POLICY_OVERWRITE,   /* newest queued msg of the same type is replaced,
+                                     send fails when there is none */
+    MSG_QUEUE_POLICY_NUMOF
+} msg_queue_policy_t;
+#endif
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+/* Counters of a thread msg queue, only kept once the thread has a stats
+ * struct attached */
+typedef struct msg_queue_stats
+{
+    uint32_t enqueued;     /* msgs put into the queue */
+    uint32_t dequeued;     /* msgs taken out of the queue */
+    uint32_t blocked;      /* sends that blocked on a full queue */
+    uint32_t blocked_time; /* time senders spent blocked on a full queue, usec */
+    uint32_t rejected;     /* sends that failed on a full queue */
+    uint32_t dropped;      /* queued msgs discarded by drop-oldest */
+    uint32_t overwritten;  /* queued msgs replaced by overwrite */
+    uint16_t high_water;   /* highest number of msgs queued at once */
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+    uint32_t latency_max;  /* longest time a received msg waited, usec */
+    /* received msgs by wait time, bucket n counts waits below
+     * 2^(n + VCRTOS_CONFIG_MSG_LATENCY_HIST_SHIFT) usec, the last bucket
+     * counts the rest */
+    uint32_t latency_hist[VCRTOS_CONFIG_MSG_LATENCY_HIST_BUCKETS];
+#endif
+} msg_queue_stats_t;
+#endif
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+#define MSG_PRIORITY_AUTO (0xff)
+
+/* Per thread priority bands, the msg queue array is split evenly between
+ * the bands and each band is served FIFO, most urgent band first */
+typedef struct msg_prio_queue
+{
+    cib_t bands[VCRTOS_CONFIG_MSG_PRIORITY_BANDS];
+} msg_prio_queue_t;
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+/* Thread flag set on the owner thread when a reply completes one of its
+ * futures, reserved for the kernel from the top of the thread flags range */
+#define THREAD_FLAG_MSG_REPLY (0x8000)
+
+typedef enum
+{
+    MSG_FUTURE_IDLE,
+    MSG_FUTURE_PENDING,
+    MSG_FUTURE_DONE,
+} msg_future_state_t;
+
+/* Caller owned slot an asynchronous request gets its reply in, it has to stay
+ * valid until the reply arrived or the request got cancelled */
+typedef struct msg_future
+{
+    list_node_t node; /* entry in the pending futures of the owner */
+    msg_t reply;
+    uint16_t correlation_id;
+    kernel_pid_t owner;
+    uint8_t state;
+} msg_future_t;
+#endif
+
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+/* Lock-free queue for msgs sent from isr, written by a single isr priority
+ * level and read by the owning thread without masking interrupts. The
+ * receiver is woken up from cpu_end_of_isr(), with
+ * VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE it is woken up by the sending isr
+ * with interrupts masked. */
+typedef struct msg_isr_queue
+{
+    cib_t cib;
+    msg_t *array;
+    uint8_t pending;
+} msg_isr_queue_t;
+#endif
+
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+/* A msg matches when (msg->type & type_mask) == type, or when match returns
+ * non-zero if set. match runs with interrupts disabled and must not block. */
+typedef struct msg_filter
+{
+    uint16_t type;
+    uint16_t type_mask;
+    int (*match)(const msg_t *msg, void *arg);
+    void *arg;
+} msg_filter_t;
+#endif
+
 void msg_init(void *instance, msg_t *msg);
 
 int msg_receive(msg_t *msg);
@@ -50,16 +172,121 @@ int msg_send(msg_t *msg, kernel_pid_t pid);
 
 int msg_try_send(msg_t *msg, kernel_pid_t pid);
 
+/* Receive up to max msgs at once, msgs[0] has to be initialized with
+ * msg_init(). Blocks only while no msg is available, returns the number of
+ * msgs received. */
+int msg_receive_batch(msg_t *msgs, int max);
+
+/* Send count msgs to pid, returns the number of msgs sent or -1 when pid is
+ * not valid */
+int msg_send_batch(msg_t *msgs, int count, kernel_pid_t pid);
+
 int msg_send_receive(msg_t *msg, msg_t *reply, kernel_pid_t pid);
 
+/* Same as msg_send_receive(), returns -ETIMEDOUT when no reply arrived within
+ * timeout usec, a timeout of 0 waits forever */
+int msg_send_receive_timeout(msg_t *msg, msg_t *reply, kernel_pid_t pid, uint32_t timeout);
+
 int msg_send_to_self_queue(msg_t *msg);
 
+/* Returns -1 when the sender of msg is not reply blocked. With
+ * VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE it also returns -1 when the sender
+ * gave up on this request, e.g. its msg_send_receive_timeout() expired, and
+ * waits for the reply of another call. */
 int msg_reply(msg_t *msg, msg_t *reply);
 
 int msg_reply_in_isr(msg_t *msg, msg_t *reply);
 
+/* Print the msg queue of the current thread, and its stats when attached */
 void msg_active_thread_queue_print(void *instance);
 
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+int msg_queue_set_policy(void *instance, kernel_pid_t pid, msg_queue_policy_t policy);
+
+const char *msg_queue_policy_to_string(msg_queue_policy_t policy);
+#endif
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+/* Start counting into stats, which has to stay valid while the thread
+ * exists. NULL stops counting. */
+int msg_queue_set_stats(void *instance, kernel_pid_t pid, msg_queue_stats_t *stats);
+
+/* Copy the counters of pid, returns -1 when no stats struct is attached */
+int msg_queue_get_stats(void *instance, kernel_pid_t pid, msg_queue_stats_t *stats);
+
+int msg_queue_reset_stats(void *instance, kernel_pid_t pid);
+#endif
+
+#if VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE
+/* Copy size bytes into the inline payload, returns -1 when it does not fit */
+int msg_set_payload(msg_t *msg, const void *data, size_t size);
+
+size_t msg_get_payload_size(msg_t *msg);
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+void msg_future_init(void *instance, msg_future_t *future);
+
+/* Send msg as request to pid without waiting for the reply, which is stored
+ * into future once the server calls msg_reply(). Returns 1 or the failed
+ * msg_send() result. */
+int msg_send_async(msg_t *msg, kernel_pid_t pid, msg_future_t *future);
+
+/* Index of a done future, -1 when none is done. The future is taken, it goes
+ * back to idle and keeps its reply, so it is returned only once. */
+int msg_future_poll_any(msg_future_t *futures, int count);
+
+/* Block until one of futures is done, returns its index and takes it like
+ * msg_future_poll_any(), -1 when none of them is pending */
+int msg_future_wait_any(msg_future_t *futures, int count);
+
+/* Block until all futures are done */
+void msg_future_wait_all(msg_future_t *futures, int count);
+
+/* Forget a pending request, a late reply is dropped. A done future goes back
+ * to idle. */
+void msg_future_cancel(msg_future_t *future);
+#endif
+
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+/* ZTIMER_USEC time msg was sent, valid once it got received */
+uint32_t msg_get_timestamp(msg_t *msg);
+
+/* ZTIMER_USEC time msg entered the processing chain, equal to the timestamp
+ * unless an origin got carried along */
+uint32_t msg_get_origin(msg_t *msg);
+
+/* Carry origin with the next send of msg, e.g. to forward a received msg to
+ * the next stage while keeping its end-to-end latency */
+void msg_set_origin(msg_t *msg, uint32_t origin);
+#endif
+
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+/* Route msgs sent from isr to pid through queue, num has to be a power of 2
+ * and array has to stay valid while the thread exists. Only one isr may send
+ * to pid while queue is attached, isrs that can preempt each other corrupt
+ * it (threads sending to pid are not affected). msg_receive() takes
+ * msgs from it before the regular queue, filtered and batch receives do not
+ * look at it. NULL queue detaches it again. */
+int msg_queue_set_isr_queue(void *instance, kernel_pid_t pid, msg_isr_queue_t *queue, msg_t *array,
+                            unsigned int num);
+#endif
+
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+/* Receive the oldest queued or waiting msg matching filter, the others stay
+ * queued in order. Every attempt looks at no more than
+ * VCRTOS_CONFIG_MSG_FILTER_SCAN_LIMIT queued msgs and waiting senders, a
+ * match behind them is found once the msgs in front got received. */
+int msg_receive_filtered(msg_t *msg, const msg_filter_t *filter);
+
+/* Same as msg_receive_filtered(), returns -1 instead of blocking */
+int msg_try_receive_filtered(msg_t *msg, const msg_filter_t *filter);
+
+/* Same as msg_receive_filtered(), returns -ETIMEDOUT when no matching msg
+ * arrived within timeout usec, a timeout of 0 waits forever */
+int msg_receive_filtered_timeout(msg_t *msg, const msg_filter_t *filter, uint32_t timeout);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
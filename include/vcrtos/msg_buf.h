@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef VCRTOS_MSG_BUF_H
+#define VCRTOS_MSG_BUF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/kernel.h>
+#include <vcrtos/list.h>
+#include <vcrtos/msg.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct msg_buf_pool
+{
+    list_node_t free_list;
+    uint16_t buf_size;
+    uint16_t numof_free;
+} msg_buf_pool_t;
+
+/* Reference counted buffer, the payload follows the header. A buffer is
+ * released back to its pool, or to the heap when pool is NULL, once the
+ * last reference is dropped */
+typedef struct msg_buf
+{
+    msg_buf_pool_t *pool;
+    uint16_t refcount;
+    uint16_t size;
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+    kernel_pid_t owner; /* pid the buffer is charged to, the last one that
+                           allocated or sent it */
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    void *instance;
+#endif
+#endif
+} msg_buf_t;
+
+#define MSG_BUF_BLOCK_SIZE(buf_size) \
+    ((sizeof(msg_buf_t) + (buf_size) + sizeof(void *) - 1) & ~(sizeof(void *) - 1))
+
+#define MSG_BUF_POOL_MEMORY_SIZE(buf_size, count) (MSG_BUF_BLOCK_SIZE(buf_size) * (count))
+
+/* memory must be aligned to pointer size and hold
+ * MSG_BUF_POOL_MEMORY_SIZE(buf_size, count) bytes */
+void msg_buf_pool_init(msg_buf_pool_t *pool, void *memory, size_t buf_size, unsigned int count);
+
+unsigned int msg_buf_pool_get_numof_free(msg_buf_pool_t *pool);
+
+/* Allocate from pool, or from the heap when pool is NULL. The caller owns
+ * the only reference of the new buffer */
+msg_buf_t *msg_buf_alloc(void *instance, msg_buf_pool_t *pool, size_t size);
+
+void *msg_buf_data(msg_buf_t *buf);
+
+size_t msg_buf_size(msg_buf_t *buf);
+
+unsigned int msg_buf_refcount(msg_buf_t *buf);
+
+void msg_buf_retain(msg_buf_t *buf);
+
+void msg_buf_release(msg_buf_t *buf);
+
+/* Send buf in msg content, the reference of the caller moves to the
+ * receiver which has to release it. On failure the caller still owns buf */
+int msg_send_buf(msg_t *msg, msg_buf_t *buf, kernel_pid_t pid);
+
+int msg_try_send_buf(msg_t *msg, msg_buf_t *buf, kernel_pid_t pid);
+
+msg_buf_t *msg_get_buf(msg_t *msg);
+
+/* Send buf to every pid without copying, each receiver gets its own
+ * reference. The reference of the caller is consumed, returns the number of
+ * receivers the buffer was delivered to */
+int msg_broadcast_buf(msg_t *msg, msg_buf_t *buf, const kernel_pid_t *pids, unsigned int numof_pids);
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+/* Number of buffers allocated or last sent by pid that are not released
+ * yet */
+unsigned int msg_buf_get_outstanding(void *instance, kernel_pid_t pid);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VCRTOS_MSG_BUF_H */
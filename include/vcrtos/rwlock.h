@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef VCRTOS_RWLOCK_H
+#define VCRTOS_RWLOCK_H
+
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/list.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define RWLOCK_WRITE_LOCKED (-1)
+
+typedef struct rwlock
+{
+    list_node_t readers; /* readers waiting, ordered by priority */
+    list_node_t writers; /* writers waiting, ordered by priority */
+    int value;           /* number of active readers or RWLOCK_WRITE_LOCKED */
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    void *instance;
+#endif
+} rwlock_t;
+
+/* Readers share the lock, writers get it exclusively. A new reader is
+ * blocked as soon as a writer is waiting, and a writer releasing the lock
+ * lets all waiting readers in before the next writer, so neither side can
+ * starve the other */
+void rwlock_init(void *instance, rwlock_t *rwlock);
+
+void rwlock_read_lock(rwlock_t *rwlock);
+
+/* Returns 1 when the lock was taken, 0 otherwise */
+int rwlock_try_read_lock(rwlock_t *rwlock);
+
+/* A timeout of 0 waits forever. Returns 0 when the lock was taken or
+ * -ETIMEDOUT when the timeout expired */
+int rwlock_read_lock_timeout(rwlock_t *rwlock, uint32_t timeout);
+
+void rwlock_read_unlock(rwlock_t *rwlock);
+
+void rwlock_write_lock(rwlock_t *rwlock);
+
+/* Returns 1 when the lock was taken, 0 otherwise */
+int rwlock_try_write_lock(rwlock_t *rwlock);
+
+/* A timeout of 0 waits forever. Returns 0 when the lock was taken or
+ * -ETIMEDOUT when the timeout expired */
+int rwlock_write_lock_timeout(rwlock_t *rwlock, uint32_t timeout);
+
+void rwlock_write_unlock(rwlock_t *rwlock);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VCRTOS_RWLOCK_H */
@@ -21,7 +21,7 @@
 #include <stdint.h>
 
 #include <vcrtos/config.h>
-#include <vcrtos/mutex.h>
+#include <vcrtos/list.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -35,10 +35,12 @@ typedef enum
 
 typedef struct
 {
+    list_node_t queue;
     unsigned int value;
-    sema_state_t state;
-    mutex_t mutex;
+    uint8_t state;
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
     void *instance;
+#endif
 } sema_t;
 
 void sema_create(void *instance, sema_t *sema, unsigned int value);
@@ -47,6 +49,9 @@ void sema_destroy(sema_t *sema);
 
 int sema_post(sema_t *sema);
 
+/* A timeout of 0 waits forever. Returns 0 when the semaphore was taken,
+ * -ETIMEDOUT when the timeout expired or -ECANCELED when the semaphore got
+ * destroyed */
 int sema_wait_timed(sema_t *sema, uint64_t timeout);
 
 int sema_wait(sema_t *sema);
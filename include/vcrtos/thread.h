@@ -44,6 +44,9 @@ typedef enum
     THREAD_STATUS_FLAG_BLOCKED_ALL,
     THREAD_STATUS_MBOX_BLOCKED,
     THREAD_STATUS_COND_BLOCKED,
+    THREAD_STATUS_SEMA_BLOCKED,
+    THREAD_STATUS_RWLOCK_BLOCKED,
+    THREAD_STATUS_RECEIVE_FILTERED_BLOCKED,
     THREAD_STATUS_RUNNING,
     THREAD_STATUS_PENDING,
     THREAD_STATUS_NUMOF
@@ -52,6 +55,7 @@ typedef enum
 #define THREAD_STATUS_NOT_FOUND ((thread_status_t)-1)
 
 #if VCRTOS_CONFIG_THREAD_FLAGS_ENABLE
+/* Note: kernel flags are taken from the top of the range down */
 typedef uint16_t thread_flags_t;
 #endif
 
@@ -60,6 +64,12 @@ typedef struct thread
     char *stack_pointer;
     thread_status_t status;
     uint8_t priority;
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+    uint8_t msg_queue_policy;
+#endif
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+    uint8_t base_priority; /* priority without the one inherited from reply blocked clients */
+#endif
     kernel_pid_t pid;
 #if VCRTOS_CONFIG_THREAD_FLAGS_ENABLE
     thread_flags_t flags;
@@ -70,6 +80,12 @@ typedef struct thread
     list_node_t msg_waiters;
     cib_t msg_queue;
     msg_t *msg_array;
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    msg_prio_queue_t *msg_prio_queue;
+#endif
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    msg_queue_stats_t *msg_queue_stats;
+#endif
     char *stack_start;
     const char *name;
     int stack_size;
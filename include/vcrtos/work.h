@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef VCRTOS_WORK_H
+#define VCRTOS_WORK_H
+
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/event.h>
+#include <vcrtos/thread.h>
+#include <vcrtos/ztimer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum
+{
+    WORK_QUEUE_HIGHEST,
+    WORK_QUEUE_MEDIUM,
+    WORK_QUEUE_LOWEST,
+    WORK_QUEUE_NUMOF
+} work_queue_id_t;
+
+typedef struct work work_t;
+
+typedef void (*work_handler_func_t)(work_t *work);
+
+typedef struct work_queue
+{
+    event_queue_t event_queue;
+    thread_t *thread;
+} work_queue_t;
+
+struct work
+{
+    event_t super;
+    work_handler_func_t handler;
+    work_queue_t *queue;
+    ztimer_t timer;
+    uint8_t scheduled;
+};
+
+void work_queue_init(void *instance);
+
+work_queue_t *work_queue_get(work_queue_id_t id);
+
+void work_init(work_t *work, work_handler_func_t handler);
+
+int work_submit(work_queue_t *queue, work_t *work);
+
+int work_schedule(work_queue_t *queue, work_t *work, uint32_t delay);
+
+int work_reschedule(work_queue_t *queue, work_t *work, uint32_t delay);
+
+int work_cancel(work_t *work);
+
+int work_is_pending(work_t *work);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VCRTOS_WORK_H */
@@ -21,6 +21,7 @@
 
 #include "core/code_utils.h"
 #include "core/instance.hpp"
+#include "core/thread.hpp"
 
 #include "cli/cli.hpp"
 #include "cli/cli_server.hpp"
@@ -28,6 +29,16 @@
 namespace vc {
 namespace cli {
 
+const Interpreter::Command Interpreter::_commands[] = {
+    {"help", &Interpreter::process_help},
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+    {"msgq", &Interpreter::process_msgq},
+#endif
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    {"msgstat", &Interpreter::process_msgstat},
+#endif
+};
+
 Interpreter::Interpreter(Instance &instances)
     : _user_commands(NULL)
     , _user_commands_length(0)
@@ -91,6 +102,16 @@ void Interpreter::process_line(char *buf, uint16_t length, Server &server)
 
     cmd = buf;
 
+    for (i = 0; i < ARRAY_LENGTH(_commands); i++)
+    {
+        if (strcmp(cmd, _commands[i].name) == 0)
+        {
+            (this->*_commands[i].command_handler_func)(argc, argv);
+            _server->output_format("Done\r\n");
+            EXIT_NOW();
+        }
+    }
+
     VERIFY_OR_EXIT(_user_commands != NULL && _user_commands_length != 0);
 
     for (i = 0; i < _user_commands_length; i++)
@@ -115,6 +136,137 @@ exit:
     return;
 }
 
+void Interpreter::process_help(int argc, char *argv[])
+{
+    (void)argc;
+    (void)argv;
+
+    for (unsigned int i = 0; i < ARRAY_LENGTH(_commands); i++)
+    {
+        _server->output_format("%s\r\n", _commands[i].name);
+    }
+
+    for (unsigned int i = 0; i < _user_commands_length; i++)
+    {
+        _server->output_format("%s\r\n", _user_commands[i].name);
+    }
+}
+
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+void Interpreter::process_msgq(int argc, char *argv[])
+{
+    ThreadScheduler &scheduler = get<ThreadScheduler>();
+
+    if (argc == 0)
+    {
+        _server->output_format("pid | name                 | policy      | size   | queued\r\n");
+
+        for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++)
+        {
+            Thread *thread = scheduler.get_thread_from_scheduler(pid);
+
+            if (thread == NULL || !thread->has_msg_queue())
+            {
+                continue;
+            }
+
+            _server->output_format("%3d | %-20s | %-11s | %6d | %6d\r\n", pid, thread->get_name(),
+                                   msg_queue_policy_to_string(thread->get_msg_queue_policy()),
+                                   thread->get_msg_queue_size(), thread->get_numof_msg_in_queue());
+        }
+
+        EXIT_NOW();
+    }
+
+    long pid;
+
+    if (argc == 2 && parse_long(argv[0], pid))
+    {
+        Thread *thread = scheduler.get_thread_from_scheduler(static_cast<kernel_pid_t>(pid));
+
+        VERIFY_OR_EXIT(thread != NULL, _server->output_format("Invalid pid\r\n"));
+
+        for (int policy = MSG_QUEUE_POLICY_BLOCK; policy < MSG_QUEUE_POLICY_NUMOF; policy++)
+        {
+            if (strcmp(argv[1], msg_queue_policy_to_string(static_cast<msg_queue_policy_t>(policy))) == 0)
+            {
+                thread->set_msg_queue_policy(static_cast<msg_queue_policy_t>(policy));
+                EXIT_NOW();
+            }
+        }
+    }
+
+    _server->output_format("Usage: msgq [<pid> block|reject|drop-oldest|overwrite]\r\n");
+
+exit:
+    return;
+}
+#endif
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+void Interpreter::process_msgstat(int argc, char *argv[])
+{
+    ThreadScheduler &scheduler = get<ThreadScheduler>();
+
+    if (argc == 0)
+    {
+        _server->output_format("pid | name                 | size   | queued | hwm    | enqueued | dequeued | blocked  | "
+                               "blocked us | rejected | dropped  | overwritten\r\n");
+
+        for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; pid++)
+        {
+            Thread *thread = scheduler.get_thread_from_scheduler(pid);
+
+            if (thread == NULL || !thread->has_msg_queue())
+            {
+                continue;
+            }
+
+            _server->output_format("%3d | %-20s | %6d | %6d", pid, thread->get_name(), thread->get_msg_queue_size(),
+                                   thread->get_numof_msg_in_queue());
+
+            msg_queue_stats_t *stats = thread->get_msg_queue_stats();
+
+            if (stats != NULL)
+            {
+                _server->output_format(" | %6u | %8lu | %8lu | %8lu | %10lu | %8lu | %8lu | %8lu\r\n",
+                                       stats->high_water, static_cast<unsigned long>(stats->enqueued),
+                                       static_cast<unsigned long>(stats->dequeued),
+                                       static_cast<unsigned long>(stats->blocked),
+                                       static_cast<unsigned long>(stats->blocked_time),
+                                       static_cast<unsigned long>(stats->rejected),
+                                       static_cast<unsigned long>(stats->dropped),
+                                       static_cast<unsigned long>(stats->overwritten));
+            }
+            else
+            {
+                _server->output_format(" | %6s | %8s | %8s | %8s | %10s | %8s | %8s | %8s\r\n", "-", "-", "-", "-", "-",
+                                       "-", "-", "-");
+            }
+        }
+
+        EXIT_NOW();
+    }
+
+    long pid;
+
+    if (argc == 2 && parse_long(argv[0], pid) && strcmp(argv[1], "reset") == 0)
+    {
+        Thread *thread = scheduler.get_thread_from_scheduler(static_cast<kernel_pid_t>(pid));
+
+        VERIFY_OR_EXIT(thread != NULL, _server->output_format("Invalid pid\r\n"));
+
+        thread->reset_msg_queue_stats();
+        EXIT_NOW();
+    }
+
+    _server->output_format("Usage: msgstat [<pid> reset]\r\n");
+
+exit:
+    return;
+}
+#endif
+
 void Interpreter::set_user_commands(const cli_command_t *commands, uint8_t length)
 {
     _user_commands = commands;
@@ -57,6 +57,24 @@ private:
         MAX_ARGS = 32,
     };
 
+    struct Command
+    {
+        const char *name;
+        void (Interpreter::*command_handler_func)(int argc, char *argv[]);
+    };
+
+    void process_help(int argc, char *argv[]);
+
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+    void process_msgq(int argc, char *argv[]);
+#endif
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    void process_msgstat(int argc, char *argv[]);
+#endif
+
+    static const Command _commands[];
+
     template <typename Type> inline Type &get(void) const;
 
 #if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <vcrtos/cond.h>
+
+#include "core/cond.hpp"
+#include "core/instance.hpp"
+#include "core/mutex.hpp"
+#include "core/new.hpp"
+
+using namespace vc;
+
+void cond_init(void *instances, cond_t *cond)
+{
+    Instance &instance = *static_cast<Instance *>(instances);
+    cond = new (cond) Cond(instance);
+}
+
+void cond_wait(cond_t *cond, mutex_t *mutex)
+{
+    Cond &cnd = *static_cast<Cond *>(cond);
+    cnd.wait(static_cast<Mutex *>(mutex));
+}
+
+int cond_wait_timed(cond_t *cond, mutex_t *mutex, uint32_t timeout)
+{
+    Cond &cnd = *static_cast<Cond *>(cond);
+    return cnd.wait_timed(static_cast<Mutex *>(mutex), timeout);
+}
+
+void cond_signal(cond_t *cond)
+{
+    Cond &cnd = *static_cast<Cond *>(cond);
+    cnd.signal();
+}
+
+void cond_broadcast(cond_t *cond)
+{
+    Cond &cnd = *static_cast<Cond *>(cond);
+    cnd.broadcast();
+}
@@ -16,6 +16,7 @@
  */
 
 #include <vcrtos/config.h>
+#include <vcrtos/cpu.h>
 #include <vcrtos/event.h>
 #include <vcrtos/thread.h>
 
@@ -33,6 +34,11 @@ void event_init(event_t *event)
     event = new (event) Event();
 }
 
+void event_init_handler(event_t *event, event_handler_func_t handler)
+{
+    event = new (event) Event(handler);
+}
+
 void event_queue_init(void *instances, event_queue_t *queue)
 {
     Instance &instance = *static_cast<Instance *>(instances);
@@ -63,6 +69,12 @@ event_t *event_wait(event_queue_t *queue)
     return event_queue.event_wait();
 }
 
+void event_loop(event_queue_t *queue)
+{
+    EventQueue &event_queue = *static_cast<EventQueue *>(queue);
+    event_queue.event_loop();
+}
+
 void event_release(event_t *event)
 {
     EventQueue::event_release(reinterpret_cast<Event *>(event));
@@ -80,4 +92,55 @@ event_t *event_peek(event_queue_t *queue)
     return event_queue.event_peek();
 }
 
+void event_queue_set_coalesce(event_queue_t *queue, int enable)
+{
+    EventQueue &event_queue = *static_cast<EventQueue *>(queue);
+    event_queue.set_coalesce(enable != 0);
+}
+
+unsigned event_get_batch(event_queue_t *queue, event_batch_t *batch)
+{
+    EventQueue &event_queue = *static_cast<EventQueue *>(queue);
+    batch = new (batch) EventBatch();
+    return event_queue.event_get_batch(static_cast<EventBatch *>(batch));
+}
+
+unsigned event_wait_batch(event_queue_t *queue, event_batch_t *batch)
+{
+    EventQueue &event_queue = *static_cast<EventQueue *>(queue);
+    batch = new (batch) EventBatch();
+    return event_queue.event_wait_batch(static_cast<EventBatch *>(batch));
+}
+
+event_t *event_batch_get(event_batch_t *batch)
+{
+    return static_cast<EventBatch *>(batch)->event_get();
+}
+
+#if VCRTOS_CONFIG_THREAD_EVENT_STATS_ENABLE
+void event_queue_get_stats(event_queue_t *queue, event_queue_stats_t *stats)
+{
+    EventQueue &event_queue = *static_cast<EventQueue *>(queue);
+
+    unsigned state = cpu_irq_disable();
+    *stats = event_queue.get_stats();
+    cpu_irq_restore(state);
+}
+
+void event_queue_reset_stats(event_queue_t *queue)
+{
+    EventQueue &event_queue = *static_cast<EventQueue *>(queue);
+
+    unsigned state = cpu_irq_disable();
+    event_queue.reset_stats();
+    cpu_irq_restore(state);
+}
+
+unsigned event_queue_events_per_wakeup(event_queue_t *queue)
+{
+    EventQueue &event_queue = *static_cast<EventQueue *>(queue);
+    return event_queue.get_events_per_wakeup();
+}
+#endif
+
 #endif // #if VCRTOS_CONFIG_THREAD_EVENT_ENABLE
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <vcrtos/mbox.h>
+
+#include "core/instance.hpp"
+#include "core/mbox.hpp"
+#include "core/new.hpp"
+
+using namespace vc;
+
+void mbox_init(void *instances, mbox_t *mbox, msg_t *queue, unsigned int queue_size)
+{
+    Instance &instance = *static_cast<Instance *>(instances);
+    mbox = new (mbox) Mbox(instance, static_cast<Msg *>(queue), queue_size);
+}
+
+int mbox_put(mbox_t *mbox, msg_t *msg)
+{
+    Mbox &mb = *static_cast<Mbox *>(mbox);
+    return mb.put(static_cast<Msg *>(msg));
+}
+
+int mbox_try_put(mbox_t *mbox, msg_t *msg)
+{
+    Mbox &mb = *static_cast<Mbox *>(mbox);
+    return mb.try_put(static_cast<Msg *>(msg)) == 0;
+}
+
+int mbox_put_timeout(mbox_t *mbox, msg_t *msg, uint32_t timeout)
+{
+    Mbox &mb = *static_cast<Mbox *>(mbox);
+    return mb.put_timeout(static_cast<Msg *>(msg), timeout);
+}
+
+void mbox_get(mbox_t *mbox, msg_t *msg)
+{
+    Mbox &mb = *static_cast<Mbox *>(mbox);
+    mb.get(static_cast<Msg *>(msg));
+}
+
+int mbox_try_get(mbox_t *mbox, msg_t *msg)
+{
+    Mbox &mb = *static_cast<Mbox *>(mbox);
+    return mb.try_get(static_cast<Msg *>(msg)) == 0;
+}
+
+int mbox_get_timeout(mbox_t *mbox, msg_t *msg, uint32_t timeout)
+{
+    Mbox &mb = *static_cast<Mbox *>(mbox);
+    return mb.get_timeout(static_cast<Msg *>(msg), timeout);
+}
+
+unsigned int mbox_avail(mbox_t *mbox)
+{
+    Mbox &mb = *static_cast<Mbox *>(mbox);
+    return mb.avail();
+}
+
+unsigned int mbox_size(mbox_t *mbox)
+{
+    Mbox &mb = *static_cast<Mbox *>(mbox);
+    return mb.size();
+}
@@ -15,10 +15,14 @@
  * Authors: Darko Pancev <darko.pancev@vertexcom.com>
  */
 
+#include <stdio.h>
+
+#include <vcrtos/cpu.h>
 #include <vcrtos/msg.h>
 
 #include "core/instance.hpp"
 #include "core/msg.hpp"
+#include "core/thread.hpp"
 
 using namespace vc;
 
@@ -47,12 +51,28 @@ int msg_try_send(msg_t *msg, kernel_pid_t pid)
     return m.try_send(pid);
 }
 
+int msg_receive_batch(msg_t *msgs, int max)
+{
+    return Msg::receive_batch(static_cast<Msg *>(msgs), max);
+}
+
+int msg_send_batch(msg_t *msgs, int count, kernel_pid_t pid)
+{
+    return Msg::send_batch(static_cast<Msg *>(msgs), count, pid);
+}
+
 int msg_send_receive(msg_t *msg, msg_t *reply, kernel_pid_t pid)
 {
     Msg &m = *static_cast<Msg *>(msg);
     return m.send_receive(static_cast<Msg *>(reply), pid);
 }
 
+int msg_send_receive_timeout(msg_t *msg, msg_t *reply, kernel_pid_t pid, uint32_t timeout)
+{
+    Msg &m = *static_cast<Msg *>(msg);
+    return m.send_receive_timeout(static_cast<Msg *>(reply), pid, timeout);
+}
+
 int msg_send_to_self_queue(msg_t *msg)
 {
     Msg &m = *static_cast<Msg *>(msg);
@@ -73,6 +93,266 @@ int msg_reply_in_isr(msg_t *msg, msg_t *reply)
 
 void msg_active_thread_queue_print(void *instance)
 {
-    (void) instance;
-    // TODO:
+    Instance &instances = *static_cast<Instance *>(instance);
+    Thread *thread = instances.get<ThreadScheduler>().get_current_active_thread();
+
+    unsigned state = cpu_irq_disable();
+
+    if (!thread->has_msg_queue())
+    {
+        cpu_irq_restore(state);
+        printf("No messages or no message queue\r\n");
+        return;
+    }
+
+    int size = thread->get_msg_queue_size();
+    int queued = thread->get_numof_msg_in_queue();
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    msg_queue_stats_t stats;
+    int has_stats = (thread->get_msg_queue_stats() != NULL);
+
+    if (has_stats)
+    {
+        stats = *thread->get_msg_queue_stats();
+    }
+#endif
+
+    cpu_irq_restore(state);
+
+    printf("Message queue of thread %d (%s)\r\n", thread->get_pid(), thread->get_name());
+    printf("    size: %d, queued: %d\r\n", size, queued);
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    if (has_stats)
+    {
+        printf("    high water: %u\r\n", stats.high_water);
+        printf("    enqueued: %lu, dequeued: %lu\r\n", static_cast<unsigned long>(stats.enqueued),
+               static_cast<unsigned long>(stats.dequeued));
+        printf("    blocked sends: %lu (%lu us)\r\n", static_cast<unsigned long>(stats.blocked),
+               static_cast<unsigned long>(stats.blocked_time));
+        printf("    rejected: %lu, dropped: %lu, overwritten: %lu\r\n", static_cast<unsigned long>(stats.rejected),
+               static_cast<unsigned long>(stats.dropped), static_cast<unsigned long>(stats.overwritten));
+
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+        printf("    latency max: %lu us\r\n", static_cast<unsigned long>(stats.latency_max));
+
+        for (int i = 0; i < VCRTOS_CONFIG_MSG_LATENCY_HIST_BUCKETS; i++)
+        {
+            if (i < VCRTOS_CONFIG_MSG_LATENCY_HIST_BUCKETS - 1)
+            {
+                printf("    < %lu us: %lu\r\n", 1UL << (i + VCRTOS_CONFIG_MSG_LATENCY_HIST_SHIFT),
+                       static_cast<unsigned long>(stats.latency_hist[i]));
+            }
+            else
+            {
+                printf("    rest: %lu\r\n", static_cast<unsigned long>(stats.latency_hist[i]));
+            }
+        }
+#endif
+    }
+#endif
+}
+
+#if VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE
+int msg_set_payload(msg_t *msg, const void *data, size_t size)
+{
+    Msg &m = *static_cast<Msg *>(msg);
+    return m.set_payload(data, size);
+}
+
+size_t msg_get_payload_size(msg_t *msg)
+{
+    Msg &m = *static_cast<Msg *>(msg);
+    return m.get_payload_size();
+}
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+void msg_future_init(void *instance, msg_future_t *future)
+{
+    Instance &instances = *static_cast<Instance *>(instance);
+    MsgFuture &f = *static_cast<MsgFuture *>(future);
+    f.init(instances);
+}
+
+int msg_send_async(msg_t *msg, kernel_pid_t pid, msg_future_t *future)
+{
+    Msg &m = *static_cast<Msg *>(msg);
+    return m.send_async(pid, static_cast<MsgFuture *>(future));
+}
+
+int msg_future_poll_any(msg_future_t *futures, int count)
+{
+    return Msg::poll_any(static_cast<MsgFuture *>(futures), count);
+}
+
+int msg_future_wait_any(msg_future_t *futures, int count)
+{
+    return Msg::wait_any(static_cast<MsgFuture *>(futures), count);
+}
+
+void msg_future_wait_all(msg_future_t *futures, int count)
+{
+    Msg::wait_all(static_cast<MsgFuture *>(futures), count);
+}
+
+void msg_future_cancel(msg_future_t *future)
+{
+    Msg::cancel(static_cast<MsgFuture *>(future));
+}
+#endif
+
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+uint32_t msg_get_timestamp(msg_t *msg)
+{
+    Msg &m = *static_cast<Msg *>(msg);
+    return m.get_timestamp();
+}
+
+uint32_t msg_get_origin(msg_t *msg)
+{
+    Msg &m = *static_cast<Msg *>(msg);
+    return m.get_origin();
+}
+
+void msg_set_origin(msg_t *msg, uint32_t origin)
+{
+    Msg &m = *static_cast<Msg *>(msg);
+    m.set_origin(origin);
+}
+#endif
+
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+int msg_queue_set_policy(void *instance, kernel_pid_t pid, msg_queue_policy_t policy)
+{
+    Instance &instances = *static_cast<Instance *>(instance);
+    Thread *thread = instances.get<ThreadScheduler>().get_thread_from_scheduler(pid);
+
+    if (thread == NULL || policy >= MSG_QUEUE_POLICY_NUMOF)
+    {
+        return -1;
+    }
+
+    thread->set_msg_queue_policy(policy);
+
+    return 0;
+}
+
+const char *msg_queue_policy_to_string(msg_queue_policy_t policy)
+{
+    switch (policy)
+    {
+    case MSG_QUEUE_POLICY_BLOCK:
+        return "block";
+    case MSG_QUEUE_POLICY_REJECT:
+        return "reject";
+    case MSG_QUEUE_POLICY_DROP_OLDEST:
+        return "drop-oldest";
+    case MSG_QUEUE_POLICY_OVERWRITE:
+        return "overwrite";
+    default:
+        return "unknown";
+    }
+}
+#endif
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+int msg_queue_set_stats(void *instance, kernel_pid_t pid, msg_queue_stats_t *stats)
+{
+    Instance &instances = *static_cast<Instance *>(instance);
+    Thread *thread = instances.get<ThreadScheduler>().get_thread_from_scheduler(pid);
+
+    if (thread == NULL)
+    {
+        return -1;
+    }
+
+    unsigned state = cpu_irq_disable();
+    thread->set_msg_queue_stats(stats);
+    cpu_irq_restore(state);
+
+    return 0;
+}
+
+int msg_queue_get_stats(void *instance, kernel_pid_t pid, msg_queue_stats_t *stats)
+{
+    Instance &instances = *static_cast<Instance *>(instance);
+    Thread *thread = instances.get<ThreadScheduler>().get_thread_from_scheduler(pid);
+
+    if (thread == NULL || thread->get_msg_queue_stats() == NULL)
+    {
+        return -1;
+    }
+
+    unsigned state = cpu_irq_disable();
+    *stats = *thread->get_msg_queue_stats();
+    cpu_irq_restore(state);
+
+    return 0;
+}
+
+int msg_queue_reset_stats(void *instance, kernel_pid_t pid)
+{
+    Instance &instances = *static_cast<Instance *>(instance);
+    Thread *thread = instances.get<ThreadScheduler>().get_thread_from_scheduler(pid);
+
+    if (thread == NULL)
+    {
+        return -1;
+    }
+
+    unsigned state = cpu_irq_disable();
+    thread->reset_msg_queue_stats();
+    cpu_irq_restore(state);
+
+    return 0;
+}
+#endif
+
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+int msg_queue_set_isr_queue(void *instance, kernel_pid_t pid, msg_isr_queue_t *queue, msg_t *array,
+                            unsigned int num)
+{
+    Instance &instances = *static_cast<Instance *>(instance);
+    ThreadScheduler &scheduler = instances.get<ThreadScheduler>();
+
+    if (scheduler.get_thread_from_scheduler(pid) == NULL)
+    {
+        return -1;
+    }
+
+    MsgIsrQueue *isr_queue = static_cast<MsgIsrQueue *>(queue);
+
+    if (isr_queue != NULL)
+    {
+        isr_queue->init(static_cast<Msg *>(array), num);
+    }
+
+    unsigned state = cpu_irq_disable();
+    scheduler.set_msg_isr_queue(pid, isr_queue);
+    cpu_irq_restore(state);
+
+    return 0;
+}
+#endif
+
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+int msg_receive_filtered(msg_t *msg, const msg_filter_t *filter)
+{
+    Msg &m = *static_cast<Msg *>(msg);
+    return m.receive_filtered(static_cast<const MsgFilter *>(filter));
+}
+
+int msg_try_receive_filtered(msg_t *msg, const msg_filter_t *filter)
+{
+    Msg &m = *static_cast<Msg *>(msg);
+    return m.try_receive_filtered(static_cast<const MsgFilter *>(filter));
+}
+
+int msg_receive_filtered_timeout(msg_t *msg, const msg_filter_t *filter, uint32_t timeout)
+{
+    Msg &m = *static_cast<Msg *>(msg);
+    return m.receive_filtered_timeout(static_cast<const MsgFilter *>(filter), timeout);
 }
+#endif
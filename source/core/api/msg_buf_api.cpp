@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <vcrtos/msg_buf.h>
+
+#include "core/instance.hpp"
+#include "core/msg_buf.hpp"
+#include "core/new.hpp"
+
+using namespace vc;
+
+void msg_buf_pool_init(msg_buf_pool_t *pool, void *memory, size_t buf_size, unsigned int count)
+{
+    pool = new (pool) MsgBufPool(memory, buf_size, count);
+}
+
+unsigned int msg_buf_pool_get_numof_free(msg_buf_pool_t *pool)
+{
+    return static_cast<MsgBufPool *>(pool)->get_numof_free();
+}
+
+msg_buf_t *msg_buf_alloc(void *instances, msg_buf_pool_t *pool, size_t size)
+{
+    Instance &instance = *static_cast<Instance *>(instances);
+    return MsgBuf::alloc(instance, static_cast<MsgBufPool *>(pool), size);
+}
+
+void *msg_buf_data(msg_buf_t *buf)
+{
+    return static_cast<MsgBuf *>(buf)->get_data();
+}
+
+size_t msg_buf_size(msg_buf_t *buf)
+{
+    return static_cast<MsgBuf *>(buf)->get_size();
+}
+
+unsigned int msg_buf_refcount(msg_buf_t *buf)
+{
+    return static_cast<MsgBuf *>(buf)->get_refcount();
+}
+
+void msg_buf_retain(msg_buf_t *buf)
+{
+    static_cast<MsgBuf *>(buf)->retain();
+}
+
+void msg_buf_release(msg_buf_t *buf)
+{
+    static_cast<MsgBuf *>(buf)->release();
+}
+
+int msg_send_buf(msg_t *msg, msg_buf_t *buf, kernel_pid_t pid)
+{
+    return static_cast<MsgBuf *>(buf)->send(static_cast<Msg *>(msg), pid);
+}
+
+int msg_try_send_buf(msg_t *msg, msg_buf_t *buf, kernel_pid_t pid)
+{
+    return static_cast<MsgBuf *>(buf)->try_send(static_cast<Msg *>(msg), pid);
+}
+
+msg_buf_t *msg_get_buf(msg_t *msg)
+{
+    return MsgBuf::get(static_cast<Msg *>(msg));
+}
+
+int msg_broadcast_buf(msg_t *msg, msg_buf_t *buf, const kernel_pid_t *pids, unsigned int numof_pids)
+{
+    return static_cast<MsgBuf *>(buf)->broadcast(static_cast<Msg *>(msg), pids, numof_pids);
+}
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+unsigned int msg_buf_get_outstanding(void *instances, kernel_pid_t pid)
+{
+    Instance &instance = *static_cast<Instance *>(instances);
+    return MsgBuf::get_outstanding(instance, pid);
+}
+#endif
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <vcrtos/rwlock.h>
+
+#include "core/instance.hpp"
+#include "core/new.hpp"
+#include "core/rwlock.hpp"
+
+using namespace vc;
+
+void rwlock_init(void *instances, rwlock_t *rwlock)
+{
+    Instance &instance = *static_cast<Instance *>(instances);
+    rwlock = new (rwlock) RwLock(instance);
+}
+
+void rwlock_read_lock(rwlock_t *rwlock)
+{
+    RwLock &lock = *static_cast<RwLock *>(rwlock);
+    lock.read_lock();
+}
+
+int rwlock_try_read_lock(rwlock_t *rwlock)
+{
+    RwLock &lock = *static_cast<RwLock *>(rwlock);
+    return lock.try_read_lock();
+}
+
+int rwlock_read_lock_timeout(rwlock_t *rwlock, uint32_t timeout)
+{
+    RwLock &lock = *static_cast<RwLock *>(rwlock);
+    return lock.read_lock_timeout(timeout);
+}
+
+void rwlock_read_unlock(rwlock_t *rwlock)
+{
+    RwLock &lock = *static_cast<RwLock *>(rwlock);
+    lock.read_unlock();
+}
+
+void rwlock_write_lock(rwlock_t *rwlock)
+{
+    RwLock &lock = *static_cast<RwLock *>(rwlock);
+    lock.write_lock();
+}
+
+int rwlock_try_write_lock(rwlock_t *rwlock)
+{
+    RwLock &lock = *static_cast<RwLock *>(rwlock);
+    return lock.try_write_lock();
+}
+
+int rwlock_write_lock_timeout(rwlock_t *rwlock, uint32_t timeout)
+{
+    RwLock &lock = *static_cast<RwLock *>(rwlock);
+    return lock.write_lock_timeout(timeout);
+}
+
+void rwlock_write_unlock(rwlock_t *rwlock)
+{
+    RwLock &lock = *static_cast<RwLock *>(rwlock);
+    lock.write_unlock();
+}
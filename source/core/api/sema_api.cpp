@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <vcrtos/sema.h>
+
+#include "core/instance.hpp"
+#include "core/new.hpp"
+#include "core/sema.hpp"
+
+using namespace vc;
+
+void sema_create(void *instances, sema_t *sema, unsigned int value)
+{
+    Instance &instance = *static_cast<Instance *>(instances);
+    sema = new (sema) Sema(instance, value);
+}
+
+void sema_destroy(sema_t *sema)
+{
+    Sema &sem = *static_cast<Sema *>(sema);
+    sem.destroy();
+}
+
+int sema_post(sema_t *sema)
+{
+    Sema &sem = *static_cast<Sema *>(sema);
+    return sem.post();
+}
+
+int sema_wait_timed(sema_t *sema, uint64_t timeout)
+{
+    Sema &sem = *static_cast<Sema *>(sema);
+
+    if (timeout > UINT32_MAX)
+    {
+        timeout = UINT32_MAX;
+    }
+
+    return sem.wait_timed(static_cast<uint32_t>(timeout));
+}
+
+int sema_wait(sema_t *sema)
+{
+    Sema &sem = *static_cast<Sema *>(sema);
+    return sem.wait();
+}
+
+int sema_try_wait(sema_t *sema)
+{
+    Sema &sem = *static_cast<Sema *>(sema);
+    return sem.try_wait();
+}
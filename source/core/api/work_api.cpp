@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <vcrtos/config.h>
+#include <vcrtos/work.h>
+
+#include "core/code_utils.h"
+#include "core/instance.hpp"
+#include "core/new.hpp"
+#include "core/thread.hpp"
+#include "core/work.hpp"
+
+#if VCRTOS_CONFIG_WORK_QUEUE_ENABLE
+
+using namespace vc;
+
+static DEFINE_ALIGNED_VAR(work_queue_raw, sizeof(WorkQueue) * WORK_QUEUE_NUMOF, uint64_t);
+
+static char _work_queue_highest_stack[VCRTOS_CONFIG_THREAD_EVENT_HIGHEST_STACK_SIZE];
+static char _work_queue_medium_stack[VCRTOS_CONFIG_THREAD_EVENT_MEDIUM_STACK_SIZE];
+static char _work_queue_lowest_stack[VCRTOS_CONFIG_THREAD_EVENT_LOWEST_STACK_SIZE];
+
+static WorkQueue *_work_queues[WORK_QUEUE_NUMOF];
+
+extern "C" void *thread_work_queue_handler(void *arg)
+{
+    WorkQueue *work_queue = static_cast<WorkQueue *>(arg);
+
+    work_queue->run();
+
+    /* should not reach here */
+
+    return NULL;
+}
+
+static void _work_queue_create(Instance &instance, work_queue_id_t id, char *stack, int size,
+                               unsigned priority, const char *name)
+{
+    WorkQueue *work_queue = new (&reinterpret_cast<WorkQueue *>(&work_queue_raw)[id]) WorkQueue(instance);
+
+    Thread *thread = Thread::init(instance, stack, size, priority,
+                                  THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                  thread_work_queue_handler, static_cast<void *>(work_queue), name);
+
+    vcassert(thread != NULL);
+
+    work_queue->set_thread(thread);
+
+    _work_queues[id] = work_queue;
+}
+
+void work_queue_init(void *instance)
+{
+    Instance &instances = *static_cast<Instance *>(instance);
+
+    _work_queue_create(instances, WORK_QUEUE_HIGHEST, _work_queue_highest_stack, sizeof(_work_queue_highest_stack),
+                       VCRTOS_CONFIG_THREAD_EVENT_HIGHEST_PRIORITY, "event-highest");
+
+    _work_queue_create(instances, WORK_QUEUE_MEDIUM, _work_queue_medium_stack, sizeof(_work_queue_medium_stack),
+                       VCRTOS_CONFIG_THREAD_EVENT_MEDIUM_PRIORITY, "event-medium");
+
+    _work_queue_create(instances, WORK_QUEUE_LOWEST, _work_queue_lowest_stack, sizeof(_work_queue_lowest_stack),
+                       VCRTOS_CONFIG_THREAD_EVENT_LOWEST_PRIORITY, "event-lowest");
+}
+
+work_queue_t *work_queue_get(work_queue_id_t id)
+{
+    vcassert(id < WORK_QUEUE_NUMOF);
+    return _work_queues[id];
+}
+
+void work_init(work_t *work, work_handler_func_t handler)
+{
+    work = new (work) Work(handler);
+}
+
+int work_submit(work_queue_t *queue, work_t *work)
+{
+    Work &w = *static_cast<Work *>(work);
+    return w.submit(static_cast<WorkQueue *>(queue));
+}
+
+int work_schedule(work_queue_t *queue, work_t *work, uint32_t delay)
+{
+    Work &w = *static_cast<Work *>(work);
+    return w.schedule(static_cast<WorkQueue *>(queue), delay);
+}
+
+int work_reschedule(work_queue_t *queue, work_t *work, uint32_t delay)
+{
+    Work &w = *static_cast<Work *>(work);
+    return w.reschedule(static_cast<WorkQueue *>(queue), delay);
+}
+
+int work_cancel(work_t *work)
+{
+    Work &w = *static_cast<Work *>(work);
+    return w.cancel();
+}
+
+int work_is_pending(work_t *work)
+{
+    Work &w = *static_cast<Work *>(work);
+    return w.is_pending();
+}
+
+#endif // #if VCRTOS_CONFIG_WORK_QUEUE_ENABLE
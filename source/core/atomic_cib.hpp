@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_ATOMIC_CIB_HPP
+#define CORE_ATOMIC_CIB_HPP
+
+#include <atomic>
+
+namespace vc {
+
+/* Multi producer multi consumer variant of Cib for use across cores or
+ * between nested isrs, lock-free by a per-slot sequence number (Vyukov
+ * bounded queue). put() and get() reserve a slot, the slot content is
+ * published with commit_put() and released with commit_get(), until then
+ * the other side keeps away from it.
+ *
+ * Note: needs a target with compare-and-swap, e.g. LDREX/STREX on ARMv7-M. */
+
+template <unsigned int Size> class AtomicCib
+{
+    static_assert(Size != 0 && !(Size & (Size - 1)), "AtomicCib size has to be a power of 2");
+
+public:
+    AtomicCib(void) { init(); }
+
+    /* Note: not thread safe, call it before the queue is shared */
+    void init(void)
+    {
+        for (unsigned int i = 0; i < Size; i++)
+        {
+            sequence[i].store(i, std::memory_order_relaxed);
+        }
+
+        read_count.store(0, std::memory_order_relaxed);
+        write_count.store(0, std::memory_order_relaxed);
+    }
+
+    /* snapshot only, may be outdated once returned */
+    unsigned int avail(void) const
+    {
+        return write_count.load(std::memory_order_relaxed) - read_count.load(std::memory_order_relaxed);
+    }
+
+    unsigned int get_mask(void) const { return Size - 1; }
+
+    int full(void) const { return avail() > get_mask(); }
+
+    int put(void)
+    {
+        unsigned int count = write_count.load(std::memory_order_relaxed);
+
+        while (1)
+        {
+            unsigned int index = count & get_mask();
+
+            int diff = static_cast<int>(sequence[index].load(std::memory_order_acquire) - count);
+
+            if (diff == 0)
+            {
+                if (write_count.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+                {
+                    return static_cast<int>(index);
+                }
+            }
+            else if (diff < 0)
+            {
+                /* slot of the previous round is not released yet */
+                return -1;
+            }
+            else
+            {
+                count = write_count.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void commit_put(int index)
+    {
+        sequence[index].store(sequence[index].load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    int get(void)
+    {
+        unsigned int count = read_count.load(std::memory_order_relaxed);
+
+        while (1)
+        {
+            unsigned int index = count & get_mask();
+
+            int diff = static_cast<int>(sequence[index].load(std::memory_order_acquire) - (count + 1));
+
+            if (diff == 0)
+            {
+                if (read_count.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+                {
+                    return static_cast<int>(index);
+                }
+            }
+            else if (diff < 0)
+            {
+                /* slot is not published yet */
+                return -1;
+            }
+            else
+            {
+                count = read_count.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void commit_get(int index)
+    {
+        sequence[index].store(sequence[index].load(std::memory_order_relaxed) + get_mask(),
+                              std::memory_order_release);
+    }
+
+    /* Index get() would return, with several consumers another one may take
+     * the slot right after */
+    int peek(void) const
+    {
+        unsigned int count = read_count.load(std::memory_order_relaxed);
+
+        unsigned int index = count & get_mask();
+
+        if (sequence[index].load(std::memory_order_acquire) != count + 1)
+        {
+            return -1;
+        }
+
+        return static_cast<int>(index);
+    }
+
+private:
+    std::atomic<unsigned int> sequence[Size];
+
+    std::atomic<unsigned int> read_count;
+
+    std::atomic<unsigned int> write_count;
+};
+
+} // namespace vc
+
+#endif /* CORE_ATOMIC_CIB_HPP */
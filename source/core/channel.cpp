@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+
+#include "core/channel.hpp"
+#include "core/instance.hpp"
+#include "core/thread.hpp"
+
+namespace vc {
+
+int ChannelBase::wait(List *queue, void *item, uint32_t timeout, WaitTimeout *wait_timeout, unsigned irqstate)
+{
+    return TimedWait::wait(get<ThreadScheduler>(), queue, THREAD_STATUS_MBOX_BLOCKED, item, timeout, wait_timeout,
+                           static_cast<void *>(this), remove_waiter, irqstate);
+}
+
+void *ChannelBase::get_waiter_item(List *queue)
+{
+    return Thread::get_thread_pointer_from_list_member(static_cast<List *>(queue->next))->wait_data;
+}
+
+void ChannelBase::wake_waiter(List *queue, unsigned irqstate)
+{
+    Thread *thread = Thread::get_thread_pointer_from_list_member(queue->remove_head());
+
+    uint8_t priority = TimedWait::wake(get<ThreadScheduler>(), thread);
+
+    cpu_irq_restore(irqstate);
+
+    get<ThreadScheduler>().context_switch(priority);
+}
+
+int ChannelBase::remove_waiter(void *owner, Thread *thread)
+{
+    ChannelBase *channel = static_cast<ChannelBase *>(owner);
+
+    int priority = TimedWait::remove(channel->get<ThreadScheduler>(), static_cast<List *>(&channel->readers), thread);
+
+    if (priority < 0)
+    {
+        priority = TimedWait::remove(channel->get<ThreadScheduler>(), static_cast<List *>(&channel->writers), thread);
+    }
+
+    return priority;
+}
+
+template <> inline Instance &ChannelBase::get(void) const
+{
+    return get_instance();
+}
+
+template <typename Type> inline Type &ChannelBase::get(void) const
+{
+    return get_instance().get<Type>();
+}
+
+} // namespace vc
@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_CHANNEL_HPP
+#define CORE_CHANNEL_HPP
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/cpu.h>
+#include <vcrtos/list.h>
+#include <vcrtos/ztimer.h>
+
+#include "core/cib.hpp"
+#include "core/list.hpp"
+#include "core/timed_wait.hpp"
+
+namespace vc {
+
+/* Note: core/new.hpp clashes with <new> when both end up in a translation
+ * unit, the slot placement uses its own tagged operator new instead */
+
+struct ChannelSlot
+{
+};
+
+} // namespace vc
+
+inline void *operator new(size_t, void *p, vc::ChannelSlot) throw()
+{
+    return p;
+}
+
+namespace vc {
+
+class Instance;
+class Thread;
+
+#if !VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+extern uint64_t instance_raw[];
+#endif
+
+/* Note: the waiting and waking part of a channel does not depend on the
+ * element type, it lives here so each Channel<T, N> only adds the moves */
+
+class ChannelBase
+{
+protected:
+    ChannelBase(Instance &instances, unsigned int size)
+        : cib(size)
+    {
+        readers.next = NULL;
+        writers.next = NULL;
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+        instance = static_cast<void *>(&instances);
+#else
+        (void)instances;
+#endif
+    }
+
+    /* returns 0 when the item was transferred by the other side, -ETIMEDOUT
+     * otherwise, irqstate is restored */
+    int wait(List *queue, void *item, uint32_t timeout, WaitTimeout *wait_timeout, unsigned irqstate);
+
+    /* item of the first thread waiting in queue */
+    static void *get_waiter_item(List *queue);
+
+    /* remove the first thread waiting in queue and make it runnable, irqstate
+     * is restored */
+    void wake_waiter(List *queue, unsigned irqstate);
+
+    list_node_t readers;
+    list_node_t writers;
+    Cib cib;
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    void *instance;
+#endif
+
+private:
+    static int remove_waiter(void *owner, Thread *thread);
+
+    template <typename Type> inline Type &get(void) const;
+
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    Instance &get_instance(void) const { return *static_cast<Instance *>(instance); }
+#else
+    Instance &get_instance(void) const { return *reinterpret_cast<Instance *>(&instance_raw); }
+#endif
+};
+
+/* Typed channel holding up to N elements of T. T only needs to be move
+ * constructible and move assignable, an element is moved once into the
+ * channel and once out of it (or once directly to a waiting receiver).
+ * send() from ISR never blocks, the timed calls return -ETIMEDOUT when
+ * the timeout expired and wait forever with a timeout of 0. */
+
+template <typename T, unsigned int N> class Channel : public ChannelBase
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "channel capacity must be a power of two");
+
+public:
+    explicit Channel(Instance &instance)
+        : ChannelBase(instance, N)
+    {
+    }
+
+    Channel(const Channel &) = delete;
+
+    Channel &operator=(const Channel &) = delete;
+
+    ~Channel(void)
+    {
+        while (cib.avail())
+        {
+            get_slot(cib.get_unsafe())->~T();
+        }
+    }
+
+    int send(T &&item) { return set_send(item, 1, 0, NULL); }
+
+    int try_send(T &&item) { return set_send(item, 0, 0, NULL); }
+
+    int send_timeout(T &&item, uint32_t timeout)
+    {
+        WaitTimeout wait_timeout;
+        return set_send(item, 1, timeout, &wait_timeout);
+    }
+
+    int send_timeout(T &&item, uint32_t timeout, WaitTimeout *wait_timeout)
+    {
+        return set_send(item, 1, timeout, wait_timeout);
+    }
+
+    int recv(T &item) { return set_recv(item, 1, 0, NULL); }
+
+    int try_recv(T &item) { return set_recv(item, 0, 0, NULL); }
+
+    int recv_timeout(T &item, uint32_t timeout)
+    {
+        WaitTimeout wait_timeout;
+        return set_recv(item, 1, timeout, &wait_timeout);
+    }
+
+    int recv_timeout(T &item, uint32_t timeout, WaitTimeout *wait_timeout)
+    {
+        return set_recv(item, 1, timeout, wait_timeout);
+    }
+
+    unsigned int avail(void) { return cib.avail(); }
+
+    static constexpr unsigned int size(void) { return N; }
+
+private:
+    int set_send(T &item, int blocking, uint32_t timeout, WaitTimeout *wait_timeout)
+    {
+        unsigned state = cpu_irq_disable();
+
+        if (readers.next)
+        {
+            /* Note: a receiver only waits on an empty channel, hand the item
+             * over directly */
+
+            *static_cast<T *>(get_waiter_item(static_cast<List *>(&readers))) = static_cast<T &&>(item);
+            wake_waiter(static_cast<List *>(&readers), state);
+            return 0;
+        }
+
+        if (!cib.full())
+        {
+            new (get_slot(cib.put_unsafe()), ChannelSlot()) T(static_cast<T &&>(item));
+            cpu_irq_restore(state);
+            return 0;
+        }
+
+        if (!blocking || cpu_is_in_isr())
+        {
+            cpu_irq_restore(state);
+            return -EAGAIN;
+        }
+
+        return wait(static_cast<List *>(&writers), &item, timeout, wait_timeout, state);
+    }
+
+    int set_recv(T &item, int blocking, uint32_t timeout, WaitTimeout *wait_timeout)
+    {
+        unsigned state = cpu_irq_disable();
+
+        if (cib.avail())
+        {
+            T *slot = get_slot(cib.get_unsafe());
+
+            item = static_cast<T &&>(*slot);
+            slot->~T();
+
+            if (writers.next == NULL)
+            {
+                cpu_irq_restore(state);
+                return 0;
+            }
+
+            /* a slot is free now, move the item of the first waiting sender in */
+
+            T *pending = static_cast<T *>(get_waiter_item(static_cast<List *>(&writers)));
+
+            new (get_slot(cib.put_unsafe()), ChannelSlot()) T(static_cast<T &&>(*pending));
+            wake_waiter(static_cast<List *>(&writers), state);
+            return 0;
+        }
+
+        if (!blocking)
+        {
+            cpu_irq_restore(state);
+            return -EAGAIN;
+        }
+
+        return wait(static_cast<List *>(&readers), &item, timeout, wait_timeout, state);
+    }
+
+    T *get_slot(int index) { return reinterpret_cast<T *>(&storage[static_cast<unsigned int>(index) * sizeof(T)]); }
+
+    alignas(T) uint8_t storage[N * sizeof(T)];
+};
+
+} // namespace vc
+
+#endif /* CORE_CHANNEL_HPP */
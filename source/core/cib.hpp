@@ -83,6 +83,62 @@ public:
     }
 };
 
+/* Single producer single consumer variant which needs no interrupt masking,
+ * e.g. one isr priority level writing and one thread reading. Each side only
+ * stores its own counter, the release store publishes the slot content and
+ * the acquire load of the other counter makes it visible. */
+
+class SpscCib : public cib_t
+{
+public:
+    explicit SpscCib(unsigned int size) { init(size); }
+
+    void init(unsigned int size)
+    {
+        vcassert(!(size & (size - 1)));
+        read_count = 0;
+        write_count = 0;
+        mask = size - 1;
+    }
+
+    unsigned int avail(void) const
+    {
+        return __atomic_load_n(&write_count, __ATOMIC_ACQUIRE) - __atomic_load_n(&read_count, __ATOMIC_ACQUIRE);
+    }
+
+    unsigned int get_mask(void) const { return mask; }
+
+    /* producer side, the slot has to be filled before commit_put() */
+    int put(void)
+    {
+        unsigned int count = __atomic_load_n(&write_count, __ATOMIC_RELAXED);
+
+        if (count - __atomic_load_n(&read_count, __ATOMIC_ACQUIRE) > mask)
+        {
+            return -1;
+        }
+
+        return static_cast<int>(count & mask);
+    }
+
+    void commit_put(void) { __atomic_store_n(&write_count, write_count + 1, __ATOMIC_RELEASE); }
+
+    /* consumer side, the slot stays valid until commit_get() */
+    int peek(void)
+    {
+        unsigned int count = __atomic_load_n(&read_count, __ATOMIC_RELAXED);
+
+        if (count == __atomic_load_n(&write_count, __ATOMIC_ACQUIRE))
+        {
+            return -1;
+        }
+
+        return static_cast<int>(count & mask);
+    }
+
+    void commit_get(void) { __atomic_store_n(&read_count, read_count + 1, __ATOMIC_RELEASE); }
+};
+
 } // namespace vc
 
 #endif /* CORE_COMMON_CIB_HPP */
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+
+#include <vcrtos/cpu.h>
+
+#include "core/cond.hpp"
+#include "core/instance.hpp"
+#include "core/thread.hpp"
+
+namespace vc {
+
+int Cond::set_wait(Mutex *mtx, uint32_t timeout, WaitTimeout *wait_timeout)
+{
+    unsigned state = cpu_irq_disable();
+
+    Thread *current_thread =
+        TimedWait::enqueue(get<ThreadScheduler>(), static_cast<List *>(&queue), THREAD_STATUS_COND_BLOCKED,
+                           static_cast<void *>(this), timeout, wait_timeout, static_cast<void *>(this), remove_waiter);
+
+    mutex = static_cast<mutex_t *>(mtx);
+
+    /* Note: the thread is already blocked on the condition when the mutex is
+     * released, so a signal sent right after the unlock can not be lost */
+
+    mtx->unlock();
+
+    /* Note: signaled or expired, the thread only runs again once it owns the
+     * mutex, wait_data tells which of both happened */
+
+    return TimedWait::sleep(current_thread, timeout, wait_timeout, state);
+}
+
+int Cond::move_to_mutex(Thread *thread)
+{
+    /* Note: instead of waking the thread up only to block it again on the
+     * mutex, it is queued on the mutex directly and runs once it owns it */
+
+    if (get_mutex()->lock_thread(thread))
+    {
+        get<ThreadScheduler>().set_thread_status(thread, THREAD_STATUS_PENDING);
+        return thread->get_priority();
+    }
+
+    return -1;
+}
+
+void Cond::signal(void)
+{
+    unsigned state = cpu_irq_disable();
+
+    List *next = (static_cast<List *>(&queue))->remove_head();
+
+    if (next == NULL)
+    {
+        cpu_irq_restore(state);
+        return;
+    }
+
+    Thread *thread = Thread::get_thread_pointer_from_list_member(next);
+
+    thread->wait_data = NULL;
+
+    int priority = move_to_mutex(thread);
+
+    cpu_irq_restore(state);
+
+    if (priority >= 0)
+    {
+        get<ThreadScheduler>().context_switch(static_cast<uint8_t>(priority));
+    }
+}
+
+void Cond::broadcast(void)
+{
+    unsigned state = cpu_irq_disable();
+
+    int priority = -1;
+
+    List *next;
+
+    while ((next = (static_cast<List *>(&queue))->remove_head()) != NULL)
+    {
+        Thread *thread = Thread::get_thread_pointer_from_list_member(next);
+
+        thread->wait_data = NULL;
+
+        int woken = move_to_mutex(thread);
+
+        if (woken >= 0)
+        {
+            /* only the first waiter can get an unlocked mutex */
+            priority = woken;
+        }
+    }
+
+    cpu_irq_restore(state);
+
+    if (priority >= 0)
+    {
+        get<ThreadScheduler>().context_switch(static_cast<uint8_t>(priority));
+    }
+}
+
+int Cond::remove_waiter(void *owner, Thread *thread)
+{
+    Cond *cond = static_cast<Cond *>(owner);
+
+    if (List::remove(static_cast<List *>(&cond->queue), static_cast<List *>(thread->get_runqueue_entry())) == NULL)
+    {
+        return -1;
+    }
+
+    /* an expired waiter gets the mutex back like a signaled one, keeping
+     * wait_data set */
+
+    return cond->move_to_mutex(thread);
+}
+
+template <> inline Instance &Cond::get(void) const
+{
+    return get_instance();
+}
+
+template <typename Type> inline Type &Cond::get(void) const
+{
+    return get_instance().get<Type>();
+}
+
+} // namespace vc
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_COND_HPP
+#define CORE_COND_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/cond.h>
+#include <vcrtos/thread.h>
+#include <vcrtos/ztimer.h>
+
+#include "core/list.hpp"
+#include "core/mutex.hpp"
+#include "core/timed_wait.hpp"
+
+namespace vc {
+
+class Instance;
+class Thread;
+
+#if !VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+extern uint64_t instance_raw[];
+#endif
+
+class Cond : public cond_t
+{
+public:
+    explicit Cond(Instance &instance)
+    {
+        init(instance);
+    }
+
+    void init(Instance &instances)
+    {
+        queue.next = NULL;
+        mutex = NULL;
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+        instance = static_cast<void *>(&instances);
+#else
+        (void)instances;
+#endif
+    }
+
+    void wait(Mutex *mtx) { set_wait(mtx, 0, NULL); }
+
+    int wait_timed(Mutex *mtx, uint32_t timeout)
+    {
+        WaitTimeout wait_timeout;
+        return wait_timed(mtx, timeout, &wait_timeout);
+    }
+
+    int wait_timed(Mutex *mtx, uint32_t timeout, WaitTimeout *wait_timeout)
+    {
+        return set_wait(mtx, timeout, wait_timeout);
+    }
+
+    void signal(void);
+
+    void broadcast(void);
+
+private:
+    int set_wait(Mutex *mtx, uint32_t timeout, WaitTimeout *wait_timeout);
+
+    int move_to_mutex(Thread *thread);
+
+    static int remove_waiter(void *owner, Thread *thread);
+
+    Mutex *get_mutex(void) { return static_cast<Mutex *>(mutex); }
+
+    template <typename Type> inline Type &get(void) const;
+
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    Instance &get_instance(void) const { return *static_cast<Instance *>(instance); }
+#else
+    Instance &get_instance(void) const { return *reinterpret_cast<Instance *>(&instance_raw); }
+#endif
+};
+
+} // namespace vc
+
+#endif /* CORE_COND_HPP */
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_DLIST_HPP
+#define CORE_DLIST_HPP
+
+#include <stddef.h>
+
+#include <vcrtos/dlist.h>
+
+namespace vc {
+
+/* Circular doubly linked list, the anchor `next` points to the last (right)
+ * node like Clist, every node in the list always have non NULL next and prev
+ * so insert, remove and peek are constant time. */
+
+class Dlist : public dlist_node_t
+{
+public:
+    Dlist(void)
+    {
+        next = NULL;
+        prev = NULL;
+    }
+
+    void right_push(Dlist *node)
+    {
+        if (this->next)
+        {
+            dlist_node_t *last = this->next;
+            dlist_node_t *first = last->next;
+
+            node->next = first;
+            node->prev = last;
+            last->next = node;
+            first->prev = node;
+        }
+        else
+        {
+            node->next = node;
+            node->prev = node;
+        }
+
+        this->next = node;
+    }
+
+    void left_push(Dlist *node)
+    {
+        if (this->next)
+        {
+            dlist_node_t *last = this->next;
+            dlist_node_t *first = last->next;
+
+            node->next = first;
+            node->prev = last;
+            last->next = node;
+            first->prev = node;
+        }
+        else
+        {
+            node->next = node;
+            node->prev = node;
+            this->next = node;
+        }
+    }
+
+    Dlist *left_pop(void)
+    {
+        if (this->next)
+        {
+            return remove(static_cast<Dlist *>(this->next->next));
+        }
+
+        return NULL;
+    }
+
+    Dlist *right_pop(void)
+    {
+        if (this->next)
+        {
+            return remove(static_cast<Dlist *>(this->next));
+        }
+
+        return NULL;
+    }
+
+    Dlist *left_peek(void)
+    {
+        if (this->next)
+        {
+            return static_cast<Dlist *>(this->next->next);
+        }
+
+        return NULL;
+    }
+
+    Dlist *right_peek(void) { return static_cast<Dlist *>(this->next); }
+
+    /* Note: node must be a member of this list, the removed node keep its
+     * next and prev pointer, caller is responsible to clear it */
+
+    Dlist *remove(Dlist *node)
+    {
+        if (node->next == node)
+        {
+            this->next = NULL;
+        }
+        else
+        {
+            node->prev->next = node->next;
+            node->next->prev = node->prev;
+
+            if (this->next == node)
+            {
+                this->next = node->prev;
+            }
+        }
+
+        return node;
+    }
+
+    int is_empty(void) const { return this->next == NULL; }
+};
+
+} // namespace vc
+
+#endif /* CORE_DLIST_HPP */
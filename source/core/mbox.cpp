@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+
+#include <vcrtos/cpu.h>
+
+#include "core/instance.hpp"
+#include "core/mbox.hpp"
+#include "core/thread.hpp"
+
+namespace vc {
+
+int Mbox::set_put(Msg *msg, int blocking, uint32_t timeout, WaitTimeout *wait_timeout)
+{
+    unsigned state = cpu_irq_disable();
+
+    if (cpu_is_in_isr())
+    {
+        msg->sender_pid = KERNEL_PID_ISR;
+        blocking = 0;
+    }
+    else
+    {
+        msg->sender_pid = get<ThreadScheduler>().get_current_active_pid();
+    }
+
+    if (readers.next)
+    {
+        /* Note: a reader can only be waiting while the mailbox is empty, copy
+         * the message straight to it */
+
+        List *next = (static_cast<List *>(&readers))->remove_head();
+
+        Thread *thread = Thread::get_thread_pointer_from_list_member(next);
+
+        static_cast<Msg *>(thread->wait_data)->copy(*msg);
+
+        uint8_t priority = TimedWait::wake(get<ThreadScheduler>(), thread);
+
+        cpu_irq_restore(state);
+
+        get<ThreadScheduler>().context_switch(priority);
+
+        return 0;
+    }
+
+    if (msg_array != NULL && !get_cib()->full())
+    {
+        get_msg(get_cib()->put_unsafe())->copy(*msg);
+        cpu_irq_restore(state);
+        return 0;
+    }
+
+    if (!blocking)
+    {
+        cpu_irq_restore(state);
+        return -EAGAIN;
+    }
+
+    return wait(static_cast<List *>(&writers), msg, timeout, wait_timeout, state);
+}
+
+int Mbox::set_get(Msg *msg, int blocking, uint32_t timeout, WaitTimeout *wait_timeout)
+{
+    unsigned state = cpu_irq_disable();
+
+    if (msg_array != NULL && get_cib()->avail())
+    {
+        msg->copy(*get_msg(get_cib()->get_unsafe()));
+
+        if (writers.next == NULL)
+        {
+            cpu_irq_restore(state);
+            return 0;
+        }
+
+        /* a slot is free now, move the message of the first waiting writer in */
+
+        List *next = (static_cast<List *>(&writers))->remove_head();
+
+        Thread *thread = Thread::get_thread_pointer_from_list_member(next);
+
+        get_msg(get_cib()->put_unsafe())->copy(*static_cast<Msg *>(thread->wait_data));
+
+        uint8_t priority = TimedWait::wake(get<ThreadScheduler>(), thread);
+
+        cpu_irq_restore(state);
+
+        get<ThreadScheduler>().context_switch(priority);
+
+        return 0;
+    }
+
+    if (writers.next)
+    {
+        /* mailbox without buffer, take the message from the writer */
+
+        List *next = (static_cast<List *>(&writers))->remove_head();
+
+        Thread *thread = Thread::get_thread_pointer_from_list_member(next);
+
+        msg->copy(*static_cast<Msg *>(thread->wait_data));
+
+        uint8_t priority = TimedWait::wake(get<ThreadScheduler>(), thread);
+
+        cpu_irq_restore(state);
+
+        get<ThreadScheduler>().context_switch(priority);
+
+        return 0;
+    }
+
+    if (!blocking)
+    {
+        cpu_irq_restore(state);
+        return -EAGAIN;
+    }
+
+    return wait(static_cast<List *>(&readers), msg, timeout, wait_timeout, state);
+}
+
+int Mbox::wait(List *queue, Msg *msg, uint32_t timeout, WaitTimeout *wait_timeout, unsigned irqstate)
+{
+    return TimedWait::wait(get<ThreadScheduler>(), queue, THREAD_STATUS_MBOX_BLOCKED, static_cast<void *>(msg), timeout,
+                           wait_timeout, static_cast<void *>(this), remove_waiter, irqstate);
+}
+
+int Mbox::remove_waiter(void *owner, Thread *thread)
+{
+    Mbox *mbox = static_cast<Mbox *>(owner);
+
+    int priority = TimedWait::remove(mbox->get<ThreadScheduler>(), static_cast<List *>(&mbox->readers), thread);
+
+    if (priority < 0)
+    {
+        priority = TimedWait::remove(mbox->get<ThreadScheduler>(), static_cast<List *>(&mbox->writers), thread);
+    }
+
+    return priority;
+}
+
+template <> inline Instance &Mbox::get(void) const
+{
+    return get_instance();
+}
+
+template <typename Type> inline Type &Mbox::get(void) const
+{
+    return get_instance().get<Type>();
+}
+
+} // namespace vc
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_MBOX_HPP
+#define CORE_MBOX_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/mbox.h>
+#include <vcrtos/thread.h>
+#include <vcrtos/ztimer.h>
+
+#include "core/cib.hpp"
+#include "core/list.hpp"
+#include "core/msg.hpp"
+#include "core/timed_wait.hpp"
+
+namespace vc {
+
+class Instance;
+class Thread;
+
+#if !VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+extern uint64_t instance_raw[];
+#endif
+
+class Mbox : public mbox_t
+{
+public:
+    explicit Mbox(Instance &instance, Msg *queue, unsigned int queue_size)
+    {
+        init(instance, queue, queue_size);
+    }
+
+    void init(Instance &instances, Msg *queue, unsigned int queue_size)
+    {
+        readers.next = NULL;
+        writers.next = NULL;
+        (static_cast<Cib *>(&cib))->init(queue_size);
+        msg_array = (queue_size != 0) ? queue : NULL;
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+        instance = static_cast<void *>(&instances);
+#else
+        (void)instances;
+#endif
+    }
+
+    int put(Msg *msg) { return set_put(msg, 1, 0, NULL); }
+
+    int try_put(Msg *msg) { return set_put(msg, 0, 0, NULL); }
+
+    int put_timeout(Msg *msg, uint32_t timeout)
+    {
+        WaitTimeout wait_timeout;
+        return put_timeout(msg, timeout, &wait_timeout);
+    }
+
+    int put_timeout(Msg *msg, uint32_t timeout, WaitTimeout *wait_timeout)
+    {
+        return set_put(msg, 1, timeout, wait_timeout);
+    }
+
+    int get(Msg *msg) { return set_get(msg, 1, 0, NULL); }
+
+    int try_get(Msg *msg) { return set_get(msg, 0, 0, NULL); }
+
+    int get_timeout(Msg *msg, uint32_t timeout)
+    {
+        WaitTimeout wait_timeout;
+        return get_timeout(msg, timeout, &wait_timeout);
+    }
+
+    int get_timeout(Msg *msg, uint32_t timeout, WaitTimeout *wait_timeout)
+    {
+        return set_get(msg, 1, timeout, wait_timeout);
+    }
+
+    unsigned int avail(void) { return (msg_array != NULL) ? get_cib()->avail() : 0; }
+
+    unsigned int size(void) { return (msg_array != NULL) ? get_cib()->get_mask() + 1 : 0; }
+
+private:
+    int set_put(Msg *msg, int blocking, uint32_t timeout, WaitTimeout *wait_timeout);
+
+    int set_get(Msg *msg, int blocking, uint32_t timeout, WaitTimeout *wait_timeout);
+
+    /* Note: wait_data of a blocked thread points to its message */
+
+    int wait(List *queue, Msg *msg, uint32_t timeout, WaitTimeout *wait_timeout, unsigned irqstate);
+
+    static int remove_waiter(void *owner, Thread *thread);
+
+    Cib *get_cib(void) { return static_cast<Cib *>(&cib); }
+
+    Msg *get_msg(int index) { return static_cast<Msg *>(&msg_array[index]); }
+
+    template <typename Type> inline Type &get(void) const;
+
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    Instance &get_instance(void) const { return *static_cast<Instance *>(instance); }
+#else
+    Instance &get_instance(void) const { return *reinterpret_cast<Instance *>(&instance_raw); }
+#endif
+};
+
+} // namespace vc
+
+#endif /* CORE_MBOX_HPP */
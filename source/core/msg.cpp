@@ -15,6 +15,9 @@
  * Authors: Darko Pancev <darko.pancev@vertexcom.com>
  */
 
+#include <errno.h>
+
+#include "core/code_utils.h"
 #include "core/instance.hpp"
 #include "core/msg.hpp"
 
@@ -37,22 +40,66 @@ int Msg::send(kernel_pid_t target_pid, int blocking, unsigned state)
         return -1;
     }
 
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+    stamp();
+#endif
+
     Thread *current_thread = get<ThreadScheduler>().get_current_active_thread();
 
     if (target_thread->get_status() != THREAD_STATUS_RECEIVE_BLOCKED)
     {
         if (target_thread->queued_msg(this))
         {
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+            if (current_thread->get_status() == THREAD_STATUS_REPLY_BLOCKED)
+            {
+                get<ThreadScheduler>().add_reply_pending(target_thread, current_thread);
+            }
+#endif
+
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+            int woken = wake_filtered_receiver(target_thread);
+#endif
+
             cpu_irq_restore(state);
 
             if (current_thread->get_status() == THREAD_STATUS_REPLY_BLOCKED)
             {
                 ThreadScheduler::yield_higher_priority_thread();
             }
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+            else if (woken)
+            {
+                get<ThreadScheduler>().context_switch(target_thread->get_priority());
+            }
+#endif
 
             return 1;
         }
 
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+        if (!target_thread->is_msg_queue_blocking())
+        {
+            blocking = 0;
+        }
+#endif
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+        msg_queue_stats_t *stats = target_thread->msg_queue_stats;
+
+        if (stats != NULL)
+        {
+            if (!blocking)
+            {
+                stats->rejected++;
+            }
+            else
+            {
+                stats->blocked++;
+            }
+        }
+#endif
+
         if (!blocking)
         {
             cpu_irq_restore(state);
@@ -76,15 +123,46 @@ int Msg::send(kernel_pid_t target_pid, int blocking, unsigned state)
 
         current_thread->add_to_list(static_cast<List *>(&target_thread->msg_waiters));
 
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+        (void)wake_filtered_receiver(target_thread);
+#endif
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+        if (new_status == THREAD_STATUS_REPLY_BLOCKED)
+        {
+            get<ThreadScheduler>().update_inherited_priority(target_thread);
+        }
+#endif
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+        ztimer_now_t blocked_since = ztimer_now(ZTIMER_USEC);
+#endif
+
         cpu_irq_restore(state);
 
         ThreadScheduler::yield_higher_priority_thread();
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+        if (stats != NULL && new_status == THREAD_STATUS_SEND_BLOCKED)
+        {
+            state = cpu_irq_disable();
+            stats->blocked_time += static_cast<uint32_t>(ztimer_now(ZTIMER_USEC) - blocked_since);
+            cpu_irq_restore(state);
+        }
+#endif
     }
     else
     {
         Msg *target_msg = static_cast<Msg *>(target_thread->wait_data);
 
-        *target_msg = *this;
+        target_msg->copy(*this);
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+        if (current_thread->get_status() == THREAD_STATUS_REPLY_BLOCKED)
+        {
+            get<ThreadScheduler>().add_reply_pending(target_thread, current_thread);
+        }
+#endif
 
         get<ThreadScheduler>().set_thread_status(target_thread, THREAD_STATUS_PENDING);
 
@@ -102,24 +180,33 @@ int Msg::receive(int blocking)
 
     Thread *current_thread = get<ThreadScheduler>().get_current_active_thread();
 
-    int queue_index = -1;
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+    MsgIsrQueue *isr_queue = get<ThreadScheduler>().get_msg_isr_queue(current_thread->get_pid());
+
+    if (isr_queue != NULL && isr_queue->pop(this))
+    {
+        cpu_irq_restore(state);
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE && VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+        record_latency(current_thread);
+#endif
+        return 1;
+    }
+#endif
+
+    int queued = 0;
 
-    if (current_thread->msg_array != NULL)
+    if (current_thread->has_msg_queue())
     {
-        queue_index = (static_cast<Cib *>(&current_thread->msg_queue))->get();
+        queued = current_thread->dequeue_msg(this);
     }
 
-    if (!blocking && (!current_thread->msg_waiters.next && queue_index == -1))
+    if (!blocking && (!current_thread->msg_waiters.next && !queued))
     {
         cpu_irq_restore(state);
         return -1;
     }
 
-    if (queue_index >= 0)
-    {
-        *this = *static_cast<Msg *>(&current_thread->msg_array[queue_index]);
-    }
-    else
+    if (!queued)
     {
         current_thread->wait_data = static_cast<void *>(this);
     }
@@ -128,7 +215,7 @@ int Msg::receive(int blocking)
 
     if (next == NULL)
     {
-        if (queue_index < 0)
+        if (!queued)
         {
             get<ThreadScheduler>().set_thread_status(current_thread, THREAD_STATUS_RECEIVE_BLOCKED);
 
@@ -145,32 +232,37 @@ int Msg::receive(int blocking)
             cpu_irq_restore(state);
         }
 
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE && VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+        record_latency(current_thread);
+#endif
+
         return 1;
     }
     else
     {
         Thread *sender_thread = Thread::get_thread_pointer_from_list_member(next);
 
-        Msg *tmp = NULL;
+        Msg *sender_msg = static_cast<Msg *>(sender_thread->wait_data);
 
-        if (queue_index >= 0)
+        if (queued)
         {
             /* We've already got a message from the queue. As there is a
              * waiter, take it's message into the just freed queue space. */
-            tmp = static_cast<Msg *>(&current_thread->msg_array[(static_cast<Cib *>(&current_thread->msg_queue))->put()]);
-        }
-
-        /* copy msg */
-        Msg *sender_msg = static_cast<Msg *>(sender_thread->wait_data);
-
-        if (tmp != NULL)
-        {
-            *tmp = *sender_msg;
-            *this = *tmp;
+            if (!current_thread->queued_msg(sender_msg))
+            {
+                /* Note: with priority bands the freed slot may belong to
+                 * another band, the sender keeps waiting */
+                sender_thread->add_to_list(static_cast<List *>(&current_thread->msg_waiters));
+                cpu_irq_restore(state);
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE && VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+                record_latency(current_thread);
+#endif
+                return 1;
+            }
         }
         else
         {
-            *this = *sender_msg;
+            copy(*sender_msg);
         }
 
         /* remove sender from queue */
@@ -184,9 +276,19 @@ int Msg::receive(int blocking)
 
             sender_priority = sender_thread->get_priority();
         }
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+        else
+        {
+            get<ThreadScheduler>().add_reply_pending(current_thread, sender_thread);
+        }
+#endif
 
         cpu_irq_restore(state);
 
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE && VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+        record_latency(current_thread);
+#endif
+
         if (sender_priority < KERNEL_THREAD_PRIORITY_IDLE)
         {
             get<ThreadScheduler>().context_switch(sender_priority);
@@ -196,155 +298,946 @@ int Msg::receive(int blocking)
     }
 }
 
-int Msg::send(kernel_pid_t target_pid)
+uint8_t Msg::release_sender(Thread *sender_thread, uint8_t priority)
 {
-    if (cpu_is_in_isr())
-    {
-        return send_in_isr(target_pid);
-    }
+    /* a sender in send_receive() keeps waiting for the reply */
 
-    if (get<ThreadScheduler>().get_current_active_pid() == target_pid)
+    if (sender_thread->get_status() == THREAD_STATUS_REPLY_BLOCKED)
     {
-        return send_to_self_queue();
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+        ThreadScheduler &scheduler = get<ThreadScheduler>();
+
+        scheduler.add_reply_pending(scheduler.get_current_active_thread(), sender_thread);
+#endif
+        return priority;
     }
 
-    return send(target_pid, 1 /* blocking */, cpu_irq_disable());
+    sender_thread->wait_data = NULL;
+
+    get<ThreadScheduler>().set_thread_status(sender_thread, THREAD_STATUS_PENDING);
+
+    return (sender_thread->get_priority() < priority) ? sender_thread->get_priority() : priority;
 }
 
-int Msg::try_send(kernel_pid_t target_pid)
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+int Msg::receive_filtered(const MsgFilter *filter, int blocking, uint32_t timeout, MsgFilterWait *wait)
 {
-    if (cpu_is_in_isr())
+    ThreadScheduler &scheduler = get<ThreadScheduler>();
+
+    MsgFilterWait local_wait;
+
+    if (wait == NULL)
     {
-        return send_in_isr(target_pid);
+        wait = &local_wait;
     }
 
-    if (get<ThreadScheduler>().get_current_active_pid() == target_pid)
+    wait->filter = filter;
+    wait->msg = this;
+    wait->thread = scheduler.get_current_active_thread();
+    wait->timed_out = 0;
+
+    int timer_armed = 0;
+
+    while (1)
     {
-        return send_to_self_queue();
-    }
+        unsigned state = cpu_irq_disable();
 
-    return send(target_pid, 0 /* non-blocking */, cpu_irq_disable());
+        Thread *current_thread = scheduler.get_current_active_thread();
+
+        unsigned int budget = VCRTOS_CONFIG_MSG_FILTER_SCAN_LIMIT;
+
+        uint8_t priority = KERNEL_THREAD_PRIORITY_IDLE;
+
+        int received = 0;
+
+        if (current_thread->has_msg_queue() && current_thread->dequeue_msg_filtered(this, filter, budget))
+        {
+            received = 1;
+
+            /* a slot got freed, take the first waiting sender in */
+
+            List *next = (static_cast<List *>(&current_thread->msg_waiters))->remove_head();
+
+            if (next != NULL)
+            {
+                Thread *sender_thread = Thread::get_thread_pointer_from_list_member(next);
+
+                if (current_thread->queued_msg(static_cast<Msg *>(sender_thread->wait_data)))
+                {
+                    priority = release_sender(sender_thread, priority);
+                }
+                else
+                {
+                    sender_thread->add_to_list(static_cast<List *>(&current_thread->msg_waiters));
+                }
+            }
+        }
+        else
+        {
+            received = take_filtered_waiter(current_thread, filter, budget, priority);
+        }
+
+        if (received)
+        {
+            cpu_irq_restore(state);
+
+            if (timer_armed)
+            {
+                ztimer_remove(ZTIMER_USEC, &wait->timer);
+            }
+
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE && VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+            record_latency(current_thread);
+#endif
+
+            if (priority < KERNEL_THREAD_PRIORITY_IDLE)
+            {
+                scheduler.context_switch(priority);
+            }
+
+            return 1;
+        }
+
+        if (!blocking || wait->timed_out)
+        {
+            cpu_irq_restore(state);
+            return wait->timed_out ? -ETIMEDOUT : -1;
+        }
+
+        current_thread->wait_data = static_cast<void *>(wait);
+
+        scheduler.set_thread_status(current_thread, THREAD_STATUS_RECEIVE_FILTERED_BLOCKED);
+
+        if (timeout != 0 && !timer_armed)
+        {
+            wait->timer.callback = handle_filter_timeout;
+            wait->timer.arg = static_cast<void *>(wait);
+            ztimer_set(ZTIMER_USEC, &wait->timer, timeout);
+            timer_armed = 1;
+        }
+
+        cpu_irq_restore(state);
+
+        ThreadScheduler::yield_higher_priority_thread();
+
+#ifdef UNITTEST
+        /* Note: on unittest build yield returns right away while the thread
+         * is still blocked, wait has to outlive the call */
+        if (current_thread->get_status() == THREAD_STATUS_RECEIVE_FILTERED_BLOCKED)
+        {
+            return 0;
+        }
+#endif
+    }
 }
 
-int Msg::send_to_self_queue(void)
+int Msg::take_filtered_waiter(Thread *receiver, const MsgFilter *filter, unsigned int &budget, uint8_t &priority)
 {
-    unsigned state = cpu_irq_disable();
+    for (List *prev = static_cast<List *>(&receiver->msg_waiters); prev->next != NULL && budget > 0;
+         prev = static_cast<List *>(prev->next))
+    {
+        budget--;
 
-    Thread *current_thread = get<ThreadScheduler>().get_current_active_thread();
+        Thread *sender_thread = Thread::get_thread_pointer_from_list_member(static_cast<List *>(prev->next));
 
-    sender_pid = current_thread->get_pid();
+        Msg *sender_msg = static_cast<Msg *>(sender_thread->wait_data);
 
-    int result = current_thread->queued_msg(this);
+        if (filter->matches(*sender_msg))
+        {
+            (void)prev->remove_head();
 
-    cpu_irq_restore(state);
+            copy(*sender_msg);
 
-    return result;
+            priority = release_sender(sender_thread, priority);
+
+            return 1;
+        }
+    }
+
+    return 0;
 }
 
-int Msg::send_in_isr(kernel_pid_t target_pid)
+int Msg::wake_filtered_receiver(Thread *receiver)
 {
-    if (!Thread::is_pid_valid(target_pid))
+    if (receiver->get_status() != THREAD_STATUS_RECEIVE_FILTERED_BLOCKED)
     {
-        // TODO: warning pit is not valid
+        return 0;
     }
 
-    Thread *target_thread = get<ThreadScheduler>().get_thread_from_scheduler(target_pid);
+    MsgFilterWait *wait = static_cast<MsgFilterWait *>(receiver->wait_data);
 
-    if (target_thread == NULL)
+    if (!wait->filter->matches(*this))
     {
-        return -1;
+        return 0;
     }
 
-    sender_pid = KERNEL_PID_ISR;
+    receiver->wait_data = NULL;
 
-    if (target_thread->get_status() == THREAD_STATUS_RECEIVE_BLOCKED)
-    {
-        Msg *target_msg = static_cast<Msg *>(target_thread->wait_data);
+    get<ThreadScheduler>().set_thread_status(receiver, THREAD_STATUS_PENDING);
+
+    return 1;
+}
 
-        *target_msg = *this;
+void Msg::handle_filter_timeout(void *arg)
+{
+    MsgFilterWait *wait = static_cast<MsgFilterWait *>(arg);
 
-        get<ThreadScheduler>().set_thread_status(target_thread, THREAD_STATUS_PENDING);
+    Thread *thread = wait->thread;
 
-        get<ThreadScheduler>().enable_context_switch_request();
+    ThreadScheduler &scheduler = wait->msg->get<ThreadScheduler>();
 
-        return 1;
+    unsigned state = cpu_irq_disable();
+
+    /* Note: a matching msg may already have woken the thread */
+
+    if (thread->get_status() != THREAD_STATUS_RECEIVE_FILTERED_BLOCKED || thread->wait_data != wait)
+    {
+        cpu_irq_restore(state);
+        return;
     }
-    else
+
+    thread->wait_data = NULL;
+
+    wait->timed_out = 1;
+
+    scheduler.set_thread_status(thread, THREAD_STATUS_PENDING);
+
+    uint8_t priority = thread->get_priority();
+
+    cpu_irq_restore(state);
+
+    scheduler.context_switch(priority);
+}
+#endif
+
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+void Msg::stamp(void)
+{
+    timestamp = static_cast<uint32_t>(ztimer_now(ZTIMER_USEC));
+
+    if (!origin_kept)
     {
-        return target_thread->queued_msg(this);
+        origin = timestamp;
     }
 }
 
-int Msg::send_receive(Msg *reply_msg, kernel_pid_t target_pid)
+uint32_t Msg::get_latency(void) const
 {
-    vcassert(get<ThreadScheduler>().get_current_active_pid() != target_pid);
+    return static_cast<uint32_t>(ztimer_now(ZTIMER_USEC)) - timestamp;
+}
+
+uint32_t Msg::get_end_to_end_latency(void) const
+{
+    return static_cast<uint32_t>(ztimer_now(ZTIMER_USEC)) - origin;
+}
 
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+void Msg::record_latency(Thread *receiver) const
+{
     unsigned state = cpu_irq_disable();
 
-    Thread *current_thread = get<ThreadScheduler>().get_current_active_thread();
+    msg_queue_stats_t *stats = receiver->msg_queue_stats;
 
-    get<ThreadScheduler>().set_thread_status(current_thread, THREAD_STATUS_REPLY_BLOCKED);
+    if (stats != NULL)
+    {
+        uint32_t latency = get_latency();
+        unsigned bucket = 0;
 
-    current_thread->wait_data = static_cast<void *>(reply_msg);
+        while (bucket < VCRTOS_CONFIG_MSG_LATENCY_HIST_BUCKETS - 1 &&
+               (latency >> (bucket + VCRTOS_CONFIG_MSG_LATENCY_HIST_SHIFT)) != 0)
+        {
+            bucket++;
+        }
 
-    /* we re-use (abuse) reply for sending, because wait_data might be
-     * overwritten if the target is not in RECEIVE_BLOCKED */
+        stats->latency_hist[bucket]++;
 
-    *reply_msg = *this;
+        if (latency > stats->latency_max)
+        {
+            stats->latency_max = latency;
+        }
+    }
 
-    /* Send() blocks until reply received */
-    return reply_msg->send(target_pid, 1 /* blocking */, state);
+    cpu_irq_restore(state);
 }
+#endif
+#endif
 
-int Msg::reply(Msg *reply_msg)
+int Msg::receive_batch(Msg *msgs, int max)
 {
+    if (max <= 0)
+    {
+        return 0;
+    }
+
     unsigned state = cpu_irq_disable();
 
-    Thread *target_thread = get<ThreadScheduler>().get_thread_from_scheduler(sender_pid);
+    Thread *current_thread = msgs->get<ThreadScheduler>().get_current_active_thread();
 
-    vcassert(target_thread != NULL);
+    List *waiters = static_cast<List *>(&current_thread->msg_waiters);
 
-    if (target_thread->get_status() != THREAD_STATUS_REPLY_BLOCKED)
-    {
-        cpu_irq_restore(state);
+    uint8_t priority = KERNEL_THREAD_PRIORITY_IDLE;
 
-        return -1;
+    int count = 0;
+
+    while (count < max && current_thread->has_msg_queue() && current_thread->dequeue_msg(&msgs[count]))
+    {
+        count++;
     }
 
-    Msg *target_msg = static_cast<Msg *>(target_thread->wait_data);
+    /* queue is empty now, take the msgs of waiting senders directly */
 
-    *target_msg = *reply_msg;
+    while (count < max && waiters->next != NULL)
+    {
+        Thread *sender_thread = Thread::get_thread_pointer_from_list_member(waiters->remove_head());
 
-    get<ThreadScheduler>().set_thread_status(target_thread, THREAD_STATUS_PENDING);
+        msgs[count++].copy(*static_cast<Msg *>(sender_thread->wait_data));
 
-    uint8_t target_prio = target_thread->get_priority();
+        priority = msgs->release_sender(sender_thread, priority);
+    }
 
-    cpu_irq_restore(state);
+    /* move waiting senders into the freed queue slots */
 
-    get<ThreadScheduler>().context_switch(target_prio);
+    while (waiters->next != NULL && current_thread->has_msg_queue())
+    {
+        List *next = waiters->remove_head();
 
-    return 1;
-}
+        Thread *sender_thread = Thread::get_thread_pointer_from_list_member(next);
 
-int Msg::reply_in_isr(Msg *reply_msg)
-{
-    Thread *target_thread = get<ThreadScheduler>().get_thread_from_scheduler(sender_pid);
+        if (!current_thread->queued_msg(static_cast<Msg *>(sender_thread->wait_data)))
+        {
+            sender_thread->add_to_list(waiters);
+            break;
+        }
 
-    if (target_thread->get_status() != THREAD_STATUS_REPLY_BLOCKED)
-    {
-        return -1;
+        priority = msgs->release_sender(sender_thread, priority);
     }
 
-    Msg *target_msg = static_cast<Msg *>(target_thread->wait_data);
+    if (count == 0)
+    {
+        current_thread->wait_data = static_cast<void *>(msgs);
 
-    *target_msg = *reply_msg;
+        msgs->get<ThreadScheduler>().set_thread_status(current_thread, THREAD_STATUS_RECEIVE_BLOCKED);
 
-    get<ThreadScheduler>().set_thread_status(target_thread, THREAD_STATUS_PENDING);
+        cpu_irq_restore(state);
 
-    get<ThreadScheduler>().enable_context_switch_request();
+        ThreadScheduler::yield_higher_priority_thread();
 
-    return 1;
-}
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE && VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+        msgs->record_latency(current_thread);
+#endif
+
+        return 1;
+    }
+
+    cpu_irq_restore(state);
+
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE && VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    for (int i = 0; i < count; i++)
+    {
+        msgs[i].record_latency(current_thread);
+    }
+#endif
+
+    if (priority < KERNEL_THREAD_PRIORITY_IDLE)
+    {
+        msgs->get<ThreadScheduler>().context_switch(priority);
+    }
+
+    return count;
+}
+
+int Msg::send_batch(Msg *msgs, int count, kernel_pid_t target_pid)
+{
+    int sent = 0;
+
+    if (cpu_is_in_isr() || msgs->get<ThreadScheduler>().get_current_active_pid() == target_pid)
+    {
+        while (sent < count && msgs[sent].send(target_pid) == 1)
+        {
+            sent++;
+        }
+
+        return sent;
+    }
+
+    unsigned state = cpu_irq_disable();
+
+    Thread *target_thread = msgs->get<ThreadScheduler>().get_thread_from_scheduler(target_pid);
+
+    if (target_thread == NULL)
+    {
+        cpu_irq_restore(state);
+        return -1;
+    }
+
+    kernel_pid_t pid = msgs->get<ThreadScheduler>().get_current_active_pid();
+
+    uint8_t priority = KERNEL_THREAD_PRIORITY_IDLE;
+
+    if (sent < count && target_thread->get_status() == THREAD_STATUS_RECEIVE_BLOCKED)
+    {
+        msgs[0].sender_pid = pid;
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+        msgs[0].stamp();
+#endif
+
+        static_cast<Msg *>(target_thread->wait_data)->copy(msgs[0]);
+
+        msgs->get<ThreadScheduler>().set_thread_status(target_thread, THREAD_STATUS_PENDING);
+
+        priority = target_thread->get_priority();
+
+        sent++;
+    }
+
+    while (sent < count && target_thread->has_msg_queue())
+    {
+        msgs[sent].sender_pid = pid;
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+        msgs[sent].stamp();
+#endif
+
+        if (!target_thread->queued_msg(&msgs[sent]))
+        {
+            break;
+        }
+
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+        if (msgs[sent].wake_filtered_receiver(target_thread))
+        {
+            priority = target_thread->get_priority();
+        }
+#endif
+
+        sent++;
+    }
+
+    cpu_irq_restore(state);
+
+    if (sent == count)
+    {
+        if (priority < KERNEL_THREAD_PRIORITY_IDLE)
+        {
+            msgs->get<ThreadScheduler>().context_switch(priority);
+        }
+
+        return sent;
+    }
+
+    /* target queue is full, the rest goes one by one blocking */
+
+    while (sent < count && msgs[sent].send(target_pid) == 1)
+    {
+        sent++;
+    }
+
+    return sent;
+}
+
+int Msg::send(kernel_pid_t target_pid)
+{
+    if (cpu_is_in_isr())
+    {
+        return send_in_isr(target_pid);
+    }
+
+    if (get<ThreadScheduler>().get_current_active_pid() == target_pid)
+    {
+        return send_to_self_queue();
+    }
+
+    return send(target_pid, 1 /* blocking */, cpu_irq_disable());
+}
+
+int Msg::try_send(kernel_pid_t target_pid)
+{
+    if (cpu_is_in_isr())
+    {
+        return send_in_isr(target_pid);
+    }
+
+    if (get<ThreadScheduler>().get_current_active_pid() == target_pid)
+    {
+        return send_to_self_queue();
+    }
+
+    return send(target_pid, 0 /* non-blocking */, cpu_irq_disable());
+}
+
+int Msg::send_to_self_queue(void)
+{
+    unsigned state = cpu_irq_disable();
+
+    Thread *current_thread = get<ThreadScheduler>().get_current_active_thread();
+
+    sender_pid = current_thread->get_pid();
+
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+    stamp();
+#endif
+
+    int result = current_thread->queued_msg(this);
+
+    cpu_irq_restore(state);
+
+    return result;
+}
+
+int Msg::send_in_isr(kernel_pid_t target_pid)
+{
+    if (!Thread::is_pid_valid(target_pid))
+    {
+        // TODO: warning pit is not valid
+    }
+
+    Thread *target_thread = get<ThreadScheduler>().get_thread_from_scheduler(target_pid);
+
+    if (target_thread == NULL)
+    {
+        return -1;
+    }
+
+    sender_pid = KERNEL_PID_ISR;
+
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+    stamp();
+#endif
+
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+    MsgIsrQueue *isr_queue = get<ThreadScheduler>().get_msg_isr_queue(target_pid);
+
+    if (isr_queue != NULL)
+    {
+        /* Note: lock-free path, the scheduler is only touched from
+         * cpu_end_of_isr() */
+        if (!isr_queue->push(*this))
+        {
+            return 0;
+        }
+
+        get<ThreadScheduler>().request_msg_isr_delivery();
+
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+        /* Note: cpu_end_of_isr() has no instance to deliver from, the msg is
+         * handed over right away with interrupts masked instead */
+        get<ThreadScheduler>().deliver_msg_isr_queues();
+#endif
+
+        return 1;
+    }
+#endif
+
+    if (target_thread->get_status() == THREAD_STATUS_RECEIVE_BLOCKED)
+    {
+        Msg *target_msg = static_cast<Msg *>(target_thread->wait_data);
+
+        target_msg->copy(*this);
+
+        get<ThreadScheduler>().set_thread_status(target_thread, THREAD_STATUS_PENDING);
+
+        get<ThreadScheduler>().enable_context_switch_request();
+
+        return 1;
+    }
+    else
+    {
+        int result = target_thread->queued_msg(this);
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+        if (result == 0 && target_thread->msg_queue_stats != NULL)
+        {
+            target_thread->msg_queue_stats->rejected++;
+        }
+#endif
+
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+        if (result == 1 && wake_filtered_receiver(target_thread))
+        {
+            get<ThreadScheduler>().enable_context_switch_request();
+        }
+#endif
+
+        return result;
+    }
+}
+
+int Msg::send_receive(Msg *reply_msg, kernel_pid_t target_pid)
+{
+    vcassert(get<ThreadScheduler>().get_current_active_pid() != target_pid);
+
+    unsigned state = cpu_irq_disable();
+
+    Thread *current_thread = get<ThreadScheduler>().get_current_active_thread();
+
+    get<ThreadScheduler>().set_thread_status(current_thread, THREAD_STATUS_REPLY_BLOCKED);
+
+    current_thread->wait_data = static_cast<void *>(reply_msg);
+
+    /* we re-use (abuse) reply for sending, because wait_data might be
+     * overwritten if the target is not in RECEIVE_BLOCKED */
+
+    reply_msg->copy(*this);
+
+#if VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE
+    reply_msg->correlation_id = get<ThreadScheduler>().get_next_msg_correlation_id();
+#endif
+
+    /* Send() blocks until reply received */
+    return reply_msg->send(target_pid, 1 /* blocking */, state);
+}
+
+int Msg::send_receive_timeout(Msg *reply_msg, kernel_pid_t target_pid, uint32_t timeout, MsgTimeout *msg_timeout)
+{
+    if (timeout == 0)
+    {
+        return send_receive(reply_msg, target_pid);
+    }
+
+    vcassert(get<ThreadScheduler>().get_current_active_pid() != target_pid);
+
+    unsigned state = cpu_irq_disable();
+
+    if (get<ThreadScheduler>().get_thread_from_scheduler(target_pid) == NULL)
+    {
+        cpu_irq_restore(state);
+        return -1;
+    }
+
+    Thread *current_thread = get<ThreadScheduler>().get_current_active_thread();
+
+    get<ThreadScheduler>().set_thread_status(current_thread, THREAD_STATUS_REPLY_BLOCKED);
+
+    current_thread->wait_data = static_cast<void *>(reply_msg);
+
+    reply_msg->copy(*this);
+
+#if VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE
+    reply_msg->correlation_id = get<ThreadScheduler>().get_next_msg_correlation_id();
+#endif
+
+    msg_timeout->reply = reply_msg;
+    msg_timeout->thread = current_thread;
+    msg_timeout->target_pid = target_pid;
+    msg_timeout->timed_out = 0;
+    msg_timeout->timer.callback = handle_timeout;
+    msg_timeout->timer.arg = static_cast<void *>(msg_timeout);
+    ztimer_set(ZTIMER_USEC, &msg_timeout->timer, timeout);
+
+    reply_msg->send(target_pid, 1 /* blocking */, state);
+
+#ifndef UNITTEST
+    /* Note: on unittest build send returns right away while the thread is
+     * still blocked, keep the timer armed so it can expire later */
+    ztimer_remove(ZTIMER_USEC, &msg_timeout->timer);
+#endif
+
+    return msg_timeout->timed_out ? -ETIMEDOUT : 1;
+}
+
+void Msg::handle_timeout(void *arg)
+{
+    MsgTimeout *msg_timeout = static_cast<MsgTimeout *>(arg);
+
+    Thread *thread = msg_timeout->thread;
+
+    ThreadScheduler &scheduler = msg_timeout->reply->get<ThreadScheduler>();
+
+    unsigned state = cpu_irq_disable();
+
+    /* Note: the reply may already be delivered */
+
+    if (thread->get_status() != THREAD_STATUS_REPLY_BLOCKED || thread->wait_data != msg_timeout->reply)
+    {
+        cpu_irq_restore(state);
+        return;
+    }
+
+    Thread *target_thread = scheduler.get_thread_from_scheduler(msg_timeout->target_pid);
+
+    if (target_thread != NULL)
+    {
+        List::remove(static_cast<List *>(&target_thread->msg_waiters), static_cast<List *>(thread->get_runqueue_entry()));
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+        scheduler.update_inherited_priority(target_thread);
+#endif
+    }
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+    scheduler.remove_reply_pending(thread);
+#endif
+
+    thread->wait_data = NULL;
+
+    msg_timeout->timed_out = 1;
+
+    scheduler.set_thread_status(thread, THREAD_STATUS_PENDING);
+
+    uint8_t priority = thread->get_priority();
+
+    cpu_irq_restore(state);
+
+    scheduler.context_switch(priority);
+}
+
+int Msg::reply(Msg *reply_msg)
+{
+    unsigned state = cpu_irq_disable();
+
+    Thread *target_thread = get<ThreadScheduler>().get_thread_from_scheduler(sender_pid);
+
+    vcassert(target_thread != NULL);
+
+    if (!target_thread->is_awaiting_reply(this))
+    {
+        cpu_irq_restore(state);
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+        if (correlation_id != 0)
+        {
+            return reply_async(reply_msg);
+        }
+#endif
+
+        return -1;
+    }
+
+    Msg *target_msg = static_cast<Msg *>(target_thread->wait_data);
+
+    target_msg->copy(*reply_msg);
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+    Thread *current_thread = get<ThreadScheduler>().get_current_active_thread();
+
+    uint8_t current_prio = current_thread->get_priority();
+
+    /* Note: must be done before the client is put back on the runqueue, both
+     * use its runqueue entry */
+
+    get<ThreadScheduler>().remove_reply_pending(target_thread);
+#endif
+
+    get<ThreadScheduler>().set_thread_status(target_thread, THREAD_STATUS_PENDING);
+
+    uint8_t target_prio = target_thread->get_priority();
+
+    cpu_irq_restore(state);
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+    if (current_thread->get_priority() > current_prio)
+    {
+        /* the inherited priority is gone, anything above the base priority
+         * runs first */
+        ThreadScheduler::yield_higher_priority_thread();
+        return 1;
+    }
+#endif
+
+    get<ThreadScheduler>().context_switch(target_prio);
+
+    return 1;
+}
+
+int Msg::reply_in_isr(Msg *reply_msg)
+{
+    Thread *target_thread = get<ThreadScheduler>().get_thread_from_scheduler(sender_pid);
+
+    if (!target_thread->is_awaiting_reply(this))
+    {
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+        if (correlation_id != 0)
+        {
+            int result = reply_async(reply_msg);
+
+            if (result == 1)
+            {
+                get<ThreadScheduler>().enable_context_switch_request();
+            }
+
+            return result;
+        }
+#endif
+
+        return -1;
+    }
+
+    Msg *target_msg = static_cast<Msg *>(target_thread->wait_data);
+
+    target_msg->copy(*reply_msg);
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+    get<ThreadScheduler>().remove_reply_pending(target_thread);
+#endif
+
+    get<ThreadScheduler>().set_thread_status(target_thread, THREAD_STATUS_PENDING);
+
+    get<ThreadScheduler>().enable_context_switch_request();
+
+    return 1;
+}
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+int Msg::send_async(kernel_pid_t target_pid, MsgFuture *future)
+{
+    vcassert(!cpu_is_in_isr());
+
+    unsigned state = cpu_irq_disable();
+
+    ThreadScheduler &scheduler = get<ThreadScheduler>();
+
+    kernel_pid_t pid = scheduler.get_current_active_pid();
+
+    /* Note: the future is registered before sending, a higher priority
+     * server replies before send() returns */
+
+    future->owner = pid;
+    future->correlation_id = scheduler.get_next_msg_correlation_id();
+    future->state = MSG_FUTURE_PENDING;
+
+    scheduler.get_msg_futures(pid)->add(static_cast<List *>(&future->node));
+
+    correlation_id = future->correlation_id;
+
+    cpu_irq_restore(state);
+
+    int result = send(target_pid);
+
+    correlation_id = 0;
+
+    if (result != 1)
+    {
+        cancel(future);
+    }
+
+    return result;
+}
+
+int Msg::reply_async(Msg *reply_msg)
+{
+    unsigned state = cpu_irq_disable();
+
+    ThreadScheduler &scheduler = get<ThreadScheduler>();
+
+    Thread *owner_thread = scheduler.get_thread_from_scheduler(sender_pid);
+
+    MsgFuture *future = NULL;
+
+    if (owner_thread != NULL)
+    {
+        List *list = scheduler.get_msg_futures(sender_pid);
+
+        /* Note: the request may have been cancelled, only pending futures of
+         * the owner are touched */
+
+        for (List *node = static_cast<List *>(list->next); node != NULL; node = static_cast<List *>(node->next))
+        {
+            MsgFuture *pending = container_of(node, MsgFuture, node);
+
+            if (pending->correlation_id == correlation_id)
+            {
+                future = pending;
+                break;
+            }
+        }
+    }
+
+    if (future == NULL)
+    {
+        cpu_irq_restore(state);
+        return -1;
+    }
+
+    List::remove(scheduler.get_msg_futures(sender_pid), static_cast<List *>(&future->node));
+
+    future->get_reply().copy(*reply_msg);
+    future->get_reply().correlation_id = correlation_id;
+    future->state = MSG_FUTURE_DONE;
+
+    cpu_irq_restore(state);
+
+    scheduler.thread_flags_set(owner_thread, THREAD_FLAG_MSG_REPLY);
+
+    return 1;
+}
+
+int Msg::poll_any(MsgFuture *futures, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (futures[i].is_done())
+        {
+            /* Note: a done future is off the owner list, no reply can touch
+             * it anymore */
+            futures[i].state = MSG_FUTURE_IDLE;
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+int Msg::is_any_pending(MsgFuture *futures, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (futures[i].is_pending())
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int Msg::wait_any(MsgFuture *futures, int count)
+{
+    ThreadScheduler &scheduler = futures->get_reply().get<ThreadScheduler>();
+
+    /* Note: the flag is cleared before looking at the futures, a reply in
+     * between sets it again and the wait returns right away */
+
+    scheduler.thread_flags_clear(THREAD_FLAG_MSG_REPLY);
+
+    while (1)
+    {
+        int index = poll_any(futures, count);
+
+        if (index >= 0 || !is_any_pending(futures, count))
+        {
+            return index;
+        }
+
+        scheduler.thread_flags_wait_any(THREAD_FLAG_MSG_REPLY);
+    }
+}
+
+void Msg::wait_all(MsgFuture *futures, int count)
+{
+    ThreadScheduler &scheduler = futures->get_reply().get<ThreadScheduler>();
+
+    scheduler.thread_flags_clear(THREAD_FLAG_MSG_REPLY);
+
+    while (is_any_pending(futures, count))
+    {
+        scheduler.thread_flags_wait_any(THREAD_FLAG_MSG_REPLY);
+    }
+}
+
+void Msg::cancel(MsgFuture *future)
+{
+    unsigned state = cpu_irq_disable();
+
+    if (future->is_pending())
+    {
+        ThreadScheduler &scheduler = future->get_reply().get<ThreadScheduler>();
+
+        List::remove(scheduler.get_msg_futures(future->owner), static_cast<List *>(&future->node));
+    }
+
+    future->state = MSG_FUTURE_IDLE;
+
+    cpu_irq_restore(state);
+}
+#endif
 
 template <> inline Instance &Msg::get(void) const
 {
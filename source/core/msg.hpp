@@ -18,15 +18,23 @@
 #ifndef CORE_MSG_HPP
 #define CORE_MSG_HPP
 
+#include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <vcrtos/assert.h>
 #include <vcrtos/config.h>
 #include <vcrtos/kernel.h>
 #include <vcrtos/msg.h>
+#include <vcrtos/ztimer.h>
 
+#include "core/cib.hpp"
 #include "core/list.hpp"
 
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE && !VCRTOS_CONFIG_THREAD_FLAGS_ENABLE
+#error "msg async require VCRTOS_CONFIG_THREAD_FLAGS_ENABLE"
+#endif
+
 namespace vc {
 
 class Thread;
@@ -38,6 +46,66 @@ class MsgBus;
 extern uint64_t instance_raw[];
 #endif
 
+class Msg;
+class MsgFuture;
+
+/* Note: wait_data of a reply blocked thread points to its reply msg, the
+ * timeout keeps track of the target so a sender still waiting for room in
+ * the target queue can be taken off it */
+
+struct MsgTimeout
+{
+    ztimer_t timer;
+    Msg *reply;
+    Thread *thread;
+    kernel_pid_t target_pid;
+    uint8_t timed_out;
+};
+
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+class MsgFilter : public msg_filter_t
+{
+public:
+    explicit MsgFilter(uint16_t filter_type, uint16_t filter_type_mask = 0xffff)
+    {
+        type = filter_type;
+        type_mask = filter_type_mask;
+        match = NULL;
+        arg = NULL;
+    }
+
+    MsgFilter(int (*filter_match)(const msg_t *msg, void *arg), void *filter_arg)
+    {
+        type = 0;
+        type_mask = 0;
+        match = filter_match;
+        arg = filter_arg;
+    }
+
+    int matches(const msg_t &msg) const
+    {
+        if (match != NULL)
+        {
+            return match(&msg, arg);
+        }
+
+        return (msg.type & type_mask) == type;
+    }
+};
+
+/* Note: wait_data of a thread blocked in a filtered receive points to its
+ * wait, senders check their msg against the filter before waking it up */
+
+struct MsgFilterWait
+{
+    ztimer_t timer;
+    const MsgFilter *filter;
+    Msg *msg;
+    Thread *thread;
+    uint8_t timed_out;
+};
+#endif
+
 class Msg : public msg_t
 {
 public:
@@ -59,8 +127,129 @@ public:
         type = 0;
         content.ptr = NULL;
         content.value = 0;
+#if VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE
+        size = 0;
+#endif
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+        priority = MSG_PRIORITY_AUTO;
+#endif
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE || VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE
+        correlation_id = 0;
+#endif
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+        origin_kept = 0;
+        timestamp = 0;
+        origin = 0;
+#endif
+    }
+
+    /* Copy src into this msg. The inline payload is copied up to its used
+     * length only, ptr and value are always carried. A kept origin is not
+     * carried over to the copy. */
+    void copy(const Msg &src)
+    {
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE || VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE
+        correlation_id = src.correlation_id;
+#endif
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+        timestamp = src.timestamp;
+        origin = src.origin;
+        origin_kept = 0;
+#endif
+#if VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+        instance = src.instance;
+#endif
+        sender_pid = src.sender_pid;
+        type = src.type;
+        size = src.size;
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+        priority = src.priority;
+#endif
+
+        size_t length = sizeof(content.ptr) > sizeof(content.value) ? sizeof(content.ptr) : sizeof(content.value);
+
+        if (size > length)
+        {
+            length = size < sizeof(content) ? size : sizeof(content);
+        }
+
+        memcpy(&content, &src.content, length);
+#else
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+        instance = src.instance;
+#endif
+        sender_pid = src.sender_pid;
+        type = src.type;
+        content = src.content;
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+        priority = src.priority;
+#endif
+#endif
     }
 
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    void set_priority(uint8_t msg_priority) { priority = msg_priority; }
+
+    uint8_t get_priority(void) const { return priority; }
+#endif
+
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+    uint32_t get_timestamp(void) const { return timestamp; }
+
+    uint32_t get_origin(void) const { return origin; }
+
+    /* Carry msg_origin with the next send instead of stamping a new one */
+    void set_origin(uint32_t msg_origin)
+    {
+        origin = msg_origin;
+        origin_kept = 1;
+    }
+
+    /* Keep the origin of a received msg when it is sent on */
+    void keep_origin(void) { origin_kept = 1; }
+
+    /* Time since the msg was sent, usec */
+    uint32_t get_latency(void) const;
+
+    /* Time since the msg entered the processing chain, usec */
+    uint32_t get_end_to_end_latency(void) const;
+#endif
+
+    template <typename Type> void set_payload(const Type &payload)
+    {
+        static_assert(sizeof(Type) <= sizeof(content), "payload exceeds VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE");
+
+        memcpy(&content, &payload, sizeof(Type));
+#if VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE
+        size = sizeof(Type);
+#endif
+    }
+
+    template <typename Type> void get_payload(Type &payload) const
+    {
+        static_assert(sizeof(Type) <= sizeof(content), "payload exceeds VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE");
+
+        memcpy(&payload, &content, sizeof(Type));
+    }
+
+#if VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE
+    int set_payload(const void *data, size_t length)
+    {
+        if (length > sizeof(content))
+        {
+            return -1;
+        }
+
+        memcpy(&content, data, length);
+        size = static_cast<uint16_t>(length);
+
+        return 0;
+    }
+
+    size_t get_payload_size(void) const { return size; }
+#endif
+
     int queued_msg(Thread *target);
 
     int send(kernel_pid_t target_pid);
@@ -77,17 +266,109 @@ public:
 
     int try_receive(void) { return receive(0); }
 
+    /* Drain up to max msgs into msgs in one critical section, blocks only
+     * while nothing is available. msgs[0] has to be initialized. */
+    static int receive_batch(Msg *msgs, int max);
+
+    /* Queue count msgs to target_pid in one critical section, falls back to
+     * blocking send once the target queue is full */
+    static int send_batch(Msg *msgs, int count, kernel_pid_t target_pid);
+
     int send_receive(Msg *reply, kernel_pid_t target_pid);
 
+    /* Same as send_receive(), returns -ETIMEDOUT when no reply arrived
+     * within timeout usec, a timeout of 0 waits forever */
+    int send_receive_timeout(Msg *reply, kernel_pid_t target_pid, uint32_t timeout)
+    {
+        MsgTimeout msg_timeout;
+        return send_receive_timeout(reply, target_pid, timeout, &msg_timeout);
+    }
+
+    int send_receive_timeout(Msg *reply, kernel_pid_t target_pid, uint32_t timeout, MsgTimeout *msg_timeout);
+
+    /* Returns -1 when the sender is not reply blocked, with the request
+     * check also when it waits for the reply of another call, e.g. because
+     * its send_receive_timeout() expired */
     int reply(Msg *reply);
 
     int reply_in_isr(Msg *reply);
 
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+    /* Receive the oldest queued or waiting msg matching filter, the others
+     * stay queued in order. An attempt looks at no more than
+     * VCRTOS_CONFIG_MSG_FILTER_SCAN_LIMIT queued msgs and waiting senders. */
+    int receive_filtered(const MsgFilter *filter) { return receive_filtered(filter, 1, 0, NULL); }
+
+    int try_receive_filtered(const MsgFilter *filter) { return receive_filtered(filter, 0, 0, NULL); }
+
+    /* Returns -ETIMEDOUT when nothing matched within timeout usec, a timeout
+     * of 0 waits forever */
+    int receive_filtered_timeout(const MsgFilter *filter, uint32_t timeout)
+    {
+        MsgFilterWait wait;
+        return receive_filtered(filter, 1, timeout, &wait);
+    }
+
+    int receive_filtered_timeout(const MsgFilter *filter, uint32_t timeout, MsgFilterWait *wait)
+    {
+        return receive_filtered(filter, 1, timeout, wait);
+    }
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+    /* Send this msg as request without waiting for the reply, reply() on the
+     * server side completes future. Returns 1 or the failed send() result. */
+    int send_async(kernel_pid_t target_pid, MsgFuture *future);
+
+    /* Index of the first done future, -1 when none is done yet. The future
+     * is taken (back to idle, reply kept) so it is returned only once. */
+    static int poll_any(MsgFuture *futures, int count);
+
+    /* Block until one of futures is done, take it and return its index, -1
+     * when none of them is pending */
+    static int wait_any(MsgFuture *futures, int count);
+
+    /* Block until no future is pending anymore */
+    static void wait_all(MsgFuture *futures, int count);
+
+    /* Forget a pending request, a late reply to it fails. A done future goes
+     * back to idle. */
+    static void cancel(MsgFuture *future);
+#endif
+
 private:
     int send(kernel_pid_t target_pid, int blocking, unsigned state);
 
     int receive(int blocking);
 
+    uint8_t release_sender(Thread *sender_thread, uint8_t priority);
+
+    static void handle_timeout(void *arg);
+
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+    int receive_filtered(const MsgFilter *filter, int blocking, uint32_t timeout, MsgFilterWait *wait);
+
+    int take_filtered_waiter(Thread *receiver, const MsgFilter *filter, unsigned int &budget, uint8_t &priority);
+
+    int wake_filtered_receiver(Thread *receiver);
+
+    static void handle_filter_timeout(void *arg);
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+    int reply_async(Msg *reply);
+
+    static int is_any_pending(MsgFuture *futures, int count);
+#endif
+
+#if VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE
+    void stamp(void);
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    void record_latency(Thread *receiver) const;
+#endif
+#endif
+
     template <typename Type> inline Type &get(void) const;
 
 #if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
@@ -97,6 +378,90 @@ private:
 #endif
 };
 
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+class MsgIsrQueue : public msg_isr_queue_t
+{
+public:
+    void init(Msg *msg_array, unsigned int num)
+    {
+        get_cib()->init(num);
+        array = msg_array;
+        pending = 0;
+    }
+
+    /* producer side, called from isr, always the same one for a queue */
+    int push(const Msg &msg)
+    {
+        int index = get_cib()->put();
+
+        if (index < 0)
+        {
+            return 0;
+        }
+
+        static_cast<Msg *>(&array[index])->copy(msg);
+
+        get_cib()->commit_put();
+
+        __atomic_store_n(&pending, 1, __ATOMIC_RELEASE);
+
+        return 1;
+    }
+
+    /* consumer side, called by the owning thread or on its behalf while it
+     * is receive blocked */
+    int pop(Msg *msg)
+    {
+        int index = get_cib()->peek();
+
+        if (index < 0)
+        {
+            return 0;
+        }
+
+        msg->copy(*static_cast<Msg *>(&array[index]));
+
+        get_cib()->commit_get();
+
+        return 1;
+    }
+
+    int test_and_clear_pending(void) { return __atomic_exchange_n(&pending, 0, __ATOMIC_ACQUIRE); }
+
+    unsigned int get_numof_msgs(void) { return get_cib()->avail(); }
+
+private:
+    SpscCib *get_cib(void) { return static_cast<SpscCib *>(&cib); }
+};
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+class MsgFuture : public msg_future_t
+{
+public:
+    MsgFuture(void) {}
+
+    explicit MsgFuture(Instance &instance) { init(instance); }
+
+    void init(Instance &instance)
+    {
+        node.next = NULL;
+        get_reply().init(instance);
+        correlation_id = 0;
+        owner = KERNEL_PID_UNDEF;
+        state = MSG_FUTURE_IDLE;
+    }
+
+    int is_pending(void) const { return state == MSG_FUTURE_PENDING; }
+
+    int is_done(void) const { return state == MSG_FUTURE_DONE; }
+
+    uint16_t get_correlation_id(void) const { return correlation_id; }
+
+    Msg &get_reply(void) { return *static_cast<Msg *>(&reply); }
+};
+#endif
+
 } // namespace vc
 
 #endif /* CORE_MSG_HPP */
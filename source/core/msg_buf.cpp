@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <vcrtos/cpu.h>
+#include <vcrtos/heap.h>
+
+#include "core/instance.hpp"
+#include "core/msg_buf.hpp"
+#include "core/thread.hpp"
+
+namespace vc {
+
+void MsgBufPool::init(void *memory, size_t size, unsigned int count)
+{
+    vcassert(size <= UINT16_MAX);
+
+    free_list.next = NULL;
+    buf_size = static_cast<uint16_t>(size);
+    numof_free = 0;
+
+    uint8_t *block = static_cast<uint8_t *>(memory);
+
+    for (unsigned int i = 0; i < count; i++)
+    {
+        free(block);
+        block += MSG_BUF_BLOCK_SIZE(size);
+    }
+}
+
+void *MsgBufPool::alloc(void)
+{
+    List *block = (static_cast<List *>(&free_list))->remove_head();
+
+    if (block)
+    {
+        numof_free--;
+    }
+
+    return block;
+}
+
+void MsgBufPool::free(void *block)
+{
+    (static_cast<List *>(&free_list))->add(static_cast<List *>(block));
+    numof_free++;
+}
+
+MsgBuf *MsgBuf::alloc(Instance &instance, MsgBufPool *pool, size_t size)
+{
+    void *block;
+
+    if (pool)
+    {
+        if (size > pool->get_buf_size())
+        {
+            return NULL;
+        }
+
+        unsigned state = cpu_irq_disable();
+        block = pool->alloc();
+        cpu_irq_restore(state);
+
+        size = pool->get_buf_size();
+    }
+    else
+    {
+        if (size > UINT16_MAX)
+        {
+            return NULL;
+        }
+
+        block = heap_malloc(sizeof(msg_buf_t) + size);
+    }
+
+    if (block == NULL)
+    {
+        return NULL;
+    }
+
+    MsgBuf *buf = static_cast<MsgBuf *>(static_cast<msg_buf_t *>(block));
+
+    buf->pool = pool;
+    buf->refcount = 1;
+    buf->size = static_cast<uint16_t>(size);
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+    buf->owner = KERNEL_PID_UNDEF;
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    buf->instance = static_cast<void *>(&instance);
+#else
+    (void)instance;
+#endif
+
+    buf->charge();
+#else
+    (void)instance;
+#endif
+
+    return buf;
+}
+
+void MsgBuf::retain(void)
+{
+    unsigned state = cpu_irq_disable();
+
+    vcassert(refcount > 0 && refcount < UINT16_MAX);
+
+    refcount++;
+
+    cpu_irq_restore(state);
+}
+
+void MsgBuf::release(void)
+{
+    unsigned state = cpu_irq_disable();
+
+    vcassert(refcount > 0);
+
+    if (--refcount > 0)
+    {
+        cpu_irq_restore(state);
+        return;
+    }
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+    get<ThreadScheduler>().uncharge_msg_buf(owner);
+#endif
+
+    MsgBufPool *buf_pool = static_cast<MsgBufPool *>(pool);
+
+    if (buf_pool)
+    {
+        buf_pool->free(this);
+        cpu_irq_restore(state);
+    }
+    else
+    {
+        cpu_irq_restore(state);
+        heap_free(this);
+    }
+}
+
+int MsgBuf::send(Msg *msg, kernel_pid_t target_pid, int blocking)
+{
+    /* Note: no reference is taken, the one of the caller moves to the
+     * receiver once the message is delivered */
+
+    msg->content.ptr = static_cast<void *>(static_cast<msg_buf_t *>(this));
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+    /* Note: charged to the sender before the send, a higher priority
+     * receiver may run and release it right away */
+    charge();
+#endif
+
+    return blocking ? msg->send(target_pid) : msg->try_send(target_pid);
+}
+
+int MsgBuf::broadcast(Msg *msg, const kernel_pid_t *pids, unsigned int numof_pids)
+{
+    int delivered = 0;
+
+    msg->content.ptr = static_cast<void *>(static_cast<msg_buf_t *>(this));
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+    charge();
+#endif
+
+    for (unsigned int i = 0; i < numof_pids; i++)
+    {
+        /* take the receiver reference before sending, a higher priority
+         * receiver may run and release it right away */
+
+        retain();
+
+        if (msg->send(pids[i]) == 1)
+        {
+            delivered++;
+        }
+        else
+        {
+            release();
+        }
+    }
+
+    release();
+
+    return delivered;
+}
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+unsigned int MsgBuf::get_outstanding(Instance &instance, kernel_pid_t pid)
+{
+    if (pid < KERNEL_PID_FIRST || pid > KERNEL_PID_LAST)
+    {
+        return 0;
+    }
+
+    return instance.get<ThreadScheduler>().get_msg_buf_outstanding(pid);
+}
+
+void MsgBuf::charge(void)
+{
+    unsigned state = cpu_irq_disable();
+
+    ThreadScheduler &scheduler = get<ThreadScheduler>();
+
+    if (owner != KERNEL_PID_UNDEF)
+    {
+        scheduler.uncharge_msg_buf(owner);
+    }
+
+    owner = cpu_is_in_isr() ? KERNEL_PID_ISR : scheduler.get_current_active_pid();
+
+    scheduler.charge_msg_buf(owner);
+
+    cpu_irq_restore(state);
+}
+
+template <> inline Instance &MsgBuf::get(void) const
+{
+    return get_instance();
+}
+
+template <typename Type> inline Type &MsgBuf::get(void) const
+{
+    return get_instance().get<Type>();
+}
+#endif
+
+} // namespace vc
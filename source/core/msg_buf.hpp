@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_MSG_BUF_HPP
+#define CORE_MSG_BUF_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/kernel.h>
+#include <vcrtos/msg_buf.h>
+
+#include "core/list.hpp"
+#include "core/msg.hpp"
+
+namespace vc {
+
+class Instance;
+
+#if !VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+extern uint64_t instance_raw[];
+#endif
+
+class MsgBufPool : public msg_buf_pool_t
+{
+public:
+    explicit MsgBufPool(void *memory, size_t size, unsigned int count) { init(memory, size, count); }
+
+    void init(void *memory, size_t size, unsigned int count);
+
+    unsigned int get_numof_free(void) const { return numof_free; }
+
+    uint16_t get_buf_size(void) const { return buf_size; }
+
+private:
+    friend class MsgBuf;
+
+    void *alloc(void);
+
+    void free(void *block);
+};
+
+class MsgBuf : public msg_buf_t
+{
+public:
+    static MsgBuf *alloc(Instance &instance, MsgBufPool *pool, size_t size);
+
+    void *get_data(void) { return reinterpret_cast<uint8_t *>(this) + sizeof(msg_buf_t); }
+
+    size_t get_size(void) const { return size; }
+
+    unsigned int get_refcount(void) const { return refcount; }
+
+    void retain(void);
+
+    void release(void);
+
+    int send(Msg *msg, kernel_pid_t target_pid) { return send(msg, target_pid, 1); }
+
+    int try_send(Msg *msg, kernel_pid_t target_pid) { return send(msg, target_pid, 0); }
+
+    int broadcast(Msg *msg, const kernel_pid_t *pids, unsigned int numof_pids);
+
+    static MsgBuf *get(Msg *msg) { return static_cast<MsgBuf *>(static_cast<msg_buf_t *>(msg->content.ptr)); }
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+    static unsigned int get_outstanding(Instance &instance, kernel_pid_t pid);
+#endif
+
+private:
+    int send(Msg *msg, kernel_pid_t target_pid, int blocking);
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+    /* charge the buffer to the current thread, or to the isr */
+    void charge(void);
+
+    template <typename Type> inline Type &get(void) const;
+
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    Instance &get_instance(void) const { return *static_cast<Instance *>(instance); }
+#else
+    Instance &get_instance(void) const { return *reinterpret_cast<Instance *>(&instance_raw); }
+#endif
+#endif
+};
+
+} // namespace vc
+
+#endif /* CORE_MSG_BUF_HPP */
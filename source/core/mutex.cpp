@@ -148,6 +148,36 @@ void Mutex::unlock_and_sleeping_current_thread(void)
     get<ThreadScheduler>().sleeping_current_thread();
 }
 
+int Mutex::lock_thread(Thread *thread)
+{
+    unsigned state = cpu_irq_disable();
+
+    if (queue.next == NULL)
+    {
+        queue.next = MUTEX_LOCKED;
+
+        cpu_irq_restore(state);
+
+        return 1;
+    }
+
+    get<ThreadScheduler>().set_thread_status(thread, THREAD_STATUS_MUTEX_BLOCKED);
+
+    if (queue.next == MUTEX_LOCKED)
+    {
+        queue.next = thread->get_runqueue_entry();
+        queue.next->next = NULL;
+    }
+    else
+    {
+        thread->add_to_list(static_cast<List *>(&queue));
+    }
+
+    cpu_irq_restore(state);
+
+    return 0;
+}
+
 template <> inline Instance &Mutex::get(void) const
 {
     return get_instance();
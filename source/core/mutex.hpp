@@ -30,6 +30,7 @@
 namespace vc {
 
 class Instance;
+class Thread;
 
 #if !VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
 extern uint64_t instance_raw[];
@@ -63,6 +64,12 @@ public:
 
     void unlock_and_sleeping_current_thread(void);
 
+    /* Note: take the mutex on behalf of an already blocked thread, returns 1
+     * when the thread owns the mutex and has to be woken up by the caller, 0
+     * when it was queued as a waiter */
+
+    int lock_thread(Thread *thread);
+
 private:
     int set_lock(int blocking);
 
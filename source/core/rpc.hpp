@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_RPC_HPP
+#define CORE_RPC_HPP
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/kernel.h>
+
+#include "core/msg.hpp"
+
+namespace vc {
+
+class Instance;
+
+/* A method of an rpc service, each method is its own type so a server
+ * handler overloads on it:
+ *
+ *     struct Add : RpcMethod<AddRequest, int32_t> {};
+ *     struct Stat : RpcMethod<uint8_t, StatResponse> {};
+ *
+ *     typedef RpcService<0x100, Add, Stat> Calc;
+ *
+ *     class CalcHandler
+ *     {
+ *     public:
+ *         void handle(Add, const AddRequest &request, int32_t &response);
+ *         void handle(Stat, const uint8_t &request, StatResponse &response);
+ *     };
+ *
+ * Request and response have to be trivially copyable. When both fit into the
+ * msg content they are carried inline, otherwise the server works on the
+ * client copies through a RpcFrame. */
+
+template <typename RequestType, typename ResponseType> struct RpcMethod
+{
+    typedef RequestType Request;
+    typedef ResponseType Response;
+
+    enum
+    {
+        is_inline = sizeof(Request) <= sizeof(msg_t::content) && sizeof(Response) <= sizeof(msg_t::content)
+    };
+};
+
+struct RpcFrame
+{
+    const void *request;
+    void *response;
+};
+
+template <bool Value> struct RpcBool
+{
+};
+
+/* Position of Method in Methods, resolved at compile time */
+
+template <typename Method, typename... Methods> struct RpcIndex;
+
+template <typename Method, typename... Rest> struct RpcIndex<Method, Method, Rest...>
+{
+    enum
+    {
+        value = 0
+    };
+};
+
+template <typename Method, typename First, typename... Rest> struct RpcIndex<Method, First, Rest...>
+{
+    enum
+    {
+        value = 1 + RpcIndex<Method, Rest...>::value
+    };
+};
+
+/* Methods get consecutive msg types starting at BaseType, the server
+ * dispatches through a table indexed by msg type */
+
+template <uint16_t BaseType, typename... Methods> class RpcService
+{
+public:
+    enum
+    {
+        STATUS_OK = 0,
+        STATUS_UNKNOWN_METHOD = 1,
+    };
+
+    enum
+    {
+        numof_methods = sizeof...(Methods)
+    };
+
+    template <typename Method> static uint16_t get_type(void)
+    {
+        return static_cast<uint16_t>(BaseType + RpcIndex<Method, Methods...>::value);
+    }
+
+    static int has_type(uint16_t type) { return type >= BaseType && type < BaseType + numof_methods; }
+
+    /* Call Method on server and block until it replied. Returns 0, -1 when
+     * server does not exist or -ENOSYS when server rejected the call. */
+    template <typename Method>
+    static int call(Instance &instance, kernel_pid_t server, const typename Method::Request &request,
+                    typename Method::Response &response)
+    {
+        Msg msg(instance);
+        Msg reply(instance);
+        RpcFrame frame;
+
+        prepare<Method>(msg, request, response, frame);
+
+        if (msg.send_receive(&reply, server) != 1)
+        {
+            return -1;
+        }
+
+        return finish<Method>(reply, response);
+    }
+
+    /* Same as call(), returns -ETIMEDOUT when server did not reply within
+     * timeout usec. The server may still handle the call later, so only
+     * inline methods can be called with a timeout. Its late reply is
+     * rejected with VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE. */
+    template <typename Method>
+    static int call_timeout(Instance &instance, kernel_pid_t server, const typename Method::Request &request,
+                            typename Method::Response &response, uint32_t timeout)
+    {
+        static_assert(Method::is_inline, "timed rpc calls need request and response to fit into a msg");
+
+        Msg msg(instance);
+        Msg reply(instance);
+        RpcFrame frame;
+
+        prepare<Method>(msg, request, response, frame);
+
+        int result = msg.send_receive_timeout(&reply, server, timeout);
+
+        if (result != 1)
+        {
+            return result;
+        }
+
+        return finish<Method>(reply, response);
+    }
+
+    /* Client side halves of call(), for callers that run the send_receive
+     * themselves. frame has to stay valid until the reply arrived. */
+    template <typename Method>
+    static void prepare(Msg &msg, const typename Method::Request &request, typename Method::Response &response,
+                        RpcFrame &frame)
+    {
+        msg.type = get_type<Method>();
+        marshal(msg, request, response, frame, RpcBool<Method::is_inline != 0>());
+    }
+
+    template <typename Method> static int finish(const Msg &reply, typename Method::Response &response)
+    {
+        if (reply.type != STATUS_OK)
+        {
+            return -ENOSYS;
+        }
+
+        unmarshal(reply, response, RpcBool<Method::is_inline != 0>());
+
+        return 0;
+    }
+
+    /* Run the handler of a received request and reply to the client. Returns
+     * -1 without replying when msg is not a request of this service. */
+    template <typename Handler> static int dispatch(Handler &handler, Msg &msg)
+    {
+        typedef void (*Invoke)(Handler & handler, Msg & msg, Msg & reply);
+
+        static const Invoke table[] = {&invoke<Handler, Methods>...};
+
+        if (!has_type(msg.type))
+        {
+            return -1;
+        }
+
+        Msg reply;
+
+        reply.copy(msg);
+        reply.type = STATUS_OK;
+
+        table[msg.type - BaseType](handler, msg, reply);
+
+        msg.reply(&reply);
+
+        return 0;
+    }
+
+    /* Reply to a request nobody handles, the client call returns -ENOSYS */
+    static void reject(Msg &msg)
+    {
+        Msg reply;
+
+        reply.copy(msg);
+        reply.type = STATUS_UNKNOWN_METHOD;
+
+        msg.reply(&reply);
+    }
+
+private:
+    template <typename Request, typename Response>
+    static void marshal(Msg &msg, const Request &request, Response &, RpcFrame &, RpcBool<true>)
+    {
+        msg.set_payload(request);
+    }
+
+    template <typename Request, typename Response>
+    static void marshal(Msg &msg, const Request &request, Response &response, RpcFrame &frame, RpcBool<false>)
+    {
+        frame.request = &request;
+        frame.response = &response;
+        msg.content.ptr = &frame;
+    }
+
+    template <typename Response> static void unmarshal(const Msg &reply, Response &response, RpcBool<true>)
+    {
+        reply.get_payload(response);
+    }
+
+    template <typename Response> static void unmarshal(const Msg &, Response &, RpcBool<false>)
+    {
+        /* the server wrote straight into the client response */
+    }
+
+    template <typename Handler, typename Method> static void invoke(Handler &handler, Msg &msg, Msg &reply)
+    {
+        invoke<Handler, Method>(handler, msg, reply, RpcBool<Method::is_inline != 0>());
+    }
+
+    template <typename Handler, typename Method>
+    static void invoke(Handler &handler, Msg &msg, Msg &reply, RpcBool<true>)
+    {
+        typename Method::Request request;
+        typename Method::Response response;
+
+        msg.get_payload(request);
+
+        handler.handle(Method(), static_cast<const typename Method::Request &>(request), response);
+
+        reply.set_payload(response);
+    }
+
+    template <typename Handler, typename Method>
+    static void invoke(Handler &handler, Msg &msg, Msg &, RpcBool<false>)
+    {
+        RpcFrame *frame = static_cast<RpcFrame *>(msg.content.ptr);
+
+        handler.handle(Method(), *static_cast<const typename Method::Request *>(frame->request),
+                       *static_cast<typename Method::Response *>(frame->response));
+    }
+};
+
+/* Client stub bound to one server thread */
+
+template <typename Service> class RpcClient
+{
+public:
+    RpcClient(Instance &instance, kernel_pid_t server)
+        : _instance(instance)
+        , _server(server)
+    {
+    }
+
+    template <typename Method>
+    int call(const typename Method::Request &request, typename Method::Response &response)
+    {
+        return Service::template call<Method>(_instance, _server, request, response);
+    }
+
+    template <typename Method>
+    int call_timeout(const typename Method::Request &request, typename Method::Response &response, uint32_t timeout)
+    {
+        return Service::template call_timeout<Method>(_instance, _server, request, response, timeout);
+    }
+
+private:
+    Instance &_instance;
+    kernel_pid_t _server;
+};
+
+} // namespace vc
+
+#endif /* CORE_RPC_HPP */
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+
+#include <vcrtos/cpu.h>
+
+#include "core/instance.hpp"
+#include "core/rwlock.hpp"
+#include "core/thread.hpp"
+
+namespace vc {
+
+int RwLock::set_read_lock(int blocking, uint32_t timeout, WaitTimeout *wait_timeout)
+{
+    unsigned state = cpu_irq_disable();
+
+    /* Note: new readers queue up behind a waiting writer */
+
+    if (value != RWLOCK_WRITE_LOCKED && writers.next == NULL)
+    {
+        value++;
+        cpu_irq_restore(state);
+        return 0;
+    }
+
+    if (!blocking)
+    {
+        cpu_irq_restore(state);
+        return -EAGAIN;
+    }
+
+    return wait(static_cast<List *>(&readers), timeout, wait_timeout, state);
+}
+
+int RwLock::set_write_lock(int blocking, uint32_t timeout, WaitTimeout *wait_timeout)
+{
+    unsigned state = cpu_irq_disable();
+
+    if (value == 0)
+    {
+        value = RWLOCK_WRITE_LOCKED;
+        cpu_irq_restore(state);
+        return 0;
+    }
+
+    if (!blocking)
+    {
+        cpu_irq_restore(state);
+        return -EAGAIN;
+    }
+
+    return wait(static_cast<List *>(&writers), timeout, wait_timeout, state);
+}
+
+int RwLock::wait(List *queue, uint32_t timeout, WaitTimeout *wait_timeout, unsigned irqstate)
+{
+    /* wait_data is cleared by the thread that handed over the lock */
+
+    return TimedWait::wait(get<ThreadScheduler>(), queue, THREAD_STATUS_RWLOCK_BLOCKED, static_cast<void *>(this),
+                           timeout, wait_timeout, static_cast<void *>(this), remove_waiter, irqstate);
+}
+
+int RwLock::grant_readers(void)
+{
+    int priority = -1;
+
+    List *next;
+
+    while ((next = (static_cast<List *>(&readers))->remove_head()) != NULL)
+    {
+        Thread *thread = Thread::get_thread_pointer_from_list_member(next);
+
+        uint8_t thread_priority = TimedWait::wake(get<ThreadScheduler>(), thread);
+
+        if (priority < 0)
+        {
+            /* the list head has the highest priority */
+            priority = thread_priority;
+        }
+
+        value++;
+    }
+
+    return priority;
+}
+
+int RwLock::grant_writer(void)
+{
+    List *next = (static_cast<List *>(&writers))->remove_head();
+
+    value = RWLOCK_WRITE_LOCKED;
+
+    return TimedWait::wake(get<ThreadScheduler>(), Thread::get_thread_pointer_from_list_member(next));
+}
+
+int RwLock::release(int prefer_readers)
+{
+    /* Note: the lock is free when this is called, a leaving writer lets the
+     * waiting readers in first and the last leaving reader hands the lock to
+     * the next writer, so reader and writer phases alternate */
+
+    if (prefer_readers && readers.next)
+    {
+        return grant_readers();
+    }
+
+    if (writers.next)
+    {
+        return grant_writer();
+    }
+
+    if (readers.next)
+    {
+        return grant_readers();
+    }
+
+    return -1;
+}
+
+void RwLock::read_unlock(void)
+{
+    unsigned state = cpu_irq_disable();
+
+    if (value <= 0)
+    {
+        /* not read locked */
+        cpu_irq_restore(state);
+        return;
+    }
+
+    int priority = -1;
+
+    if (--value == 0)
+    {
+        priority = release(0);
+    }
+
+    cpu_irq_restore(state);
+
+    if (priority >= 0)
+    {
+        get<ThreadScheduler>().context_switch(static_cast<uint8_t>(priority));
+    }
+}
+
+void RwLock::write_unlock(void)
+{
+    unsigned state = cpu_irq_disable();
+
+    if (value != RWLOCK_WRITE_LOCKED)
+    {
+        /* not write locked */
+        cpu_irq_restore(state);
+        return;
+    }
+
+    value = 0;
+
+    int priority = release(1);
+
+    cpu_irq_restore(state);
+
+    if (priority >= 0)
+    {
+        get<ThreadScheduler>().context_switch(static_cast<uint8_t>(priority));
+    }
+}
+
+int RwLock::remove_waiter(void *owner, Thread *thread)
+{
+    RwLock *rwlock = static_cast<RwLock *>(owner);
+
+    int priority = TimedWait::remove(rwlock->get<ThreadScheduler>(), static_cast<List *>(&rwlock->readers), thread);
+
+    if (priority >= 0)
+    {
+        return priority;
+    }
+
+    priority = TimedWait::remove(rwlock->get<ThreadScheduler>(), static_cast<List *>(&rwlock->writers), thread);
+
+    /* Note: readers may only be waiting because of this writer */
+
+    if (priority >= 0 && rwlock->writers.next == NULL && rwlock->value != RWLOCK_WRITE_LOCKED && rwlock->readers.next)
+    {
+        int readers_priority = rwlock->grant_readers();
+
+        if (readers_priority < priority)
+        {
+            priority = readers_priority;
+        }
+    }
+
+    return priority;
+}
+
+template <> inline Instance &RwLock::get(void) const
+{
+    return get_instance();
+}
+
+template <typename Type> inline Type &RwLock::get(void) const
+{
+    return get_instance().get<Type>();
+}
+
+} // namespace vc
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_RWLOCK_HPP
+#define CORE_RWLOCK_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/rwlock.h>
+#include <vcrtos/thread.h>
+#include <vcrtos/ztimer.h>
+
+#include "core/list.hpp"
+#include "core/timed_wait.hpp"
+
+namespace vc {
+
+class Instance;
+class Thread;
+
+#if !VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+extern uint64_t instance_raw[];
+#endif
+
+class RwLock : public rwlock_t
+{
+public:
+    explicit RwLock(Instance &instance)
+    {
+        init(instance);
+    }
+
+    void init(Instance &instances)
+    {
+        readers.next = NULL;
+        writers.next = NULL;
+        value = 0;
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+        instance = static_cast<void *>(&instances);
+#else
+        (void)instances;
+#endif
+    }
+
+    void read_lock(void) { set_read_lock(1, 0, NULL); }
+
+    int try_read_lock(void) { return set_read_lock(0, 0, NULL) == 0; }
+
+    int read_lock_timeout(uint32_t timeout)
+    {
+        WaitTimeout wait_timeout;
+        return read_lock_timeout(timeout, &wait_timeout);
+    }
+
+    int read_lock_timeout(uint32_t timeout, WaitTimeout *wait_timeout)
+    {
+        return set_read_lock(1, timeout, wait_timeout);
+    }
+
+    void read_unlock(void);
+
+    void write_lock(void) { set_write_lock(1, 0, NULL); }
+
+    int try_write_lock(void) { return set_write_lock(0, 0, NULL) == 0; }
+
+    int write_lock_timeout(uint32_t timeout)
+    {
+        WaitTimeout wait_timeout;
+        return write_lock_timeout(timeout, &wait_timeout);
+    }
+
+    int write_lock_timeout(uint32_t timeout, WaitTimeout *wait_timeout)
+    {
+        return set_write_lock(1, timeout, wait_timeout);
+    }
+
+    void write_unlock(void);
+
+    int get_numof_readers(void) const { return (value > 0) ? value : 0; }
+
+    int is_write_locked(void) const { return value == RWLOCK_WRITE_LOCKED; }
+
+private:
+    int set_read_lock(int blocking, uint32_t timeout, WaitTimeout *wait_timeout);
+
+    int set_write_lock(int blocking, uint32_t timeout, WaitTimeout *wait_timeout);
+
+    int wait(List *queue, uint32_t timeout, WaitTimeout *wait_timeout, unsigned irqstate);
+
+    int grant_readers(void);
+
+    int grant_writer(void);
+
+    int release(int prefer_readers);
+
+    static int remove_waiter(void *owner, Thread *thread);
+
+    template <typename Type> inline Type &get(void) const;
+
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    Instance &get_instance(void) const { return *static_cast<Instance *>(instance); }
+#else
+    Instance &get_instance(void) const { return *reinterpret_cast<Instance *>(&instance_raw); }
+#endif
+};
+
+} // namespace vc
+
+#endif /* CORE_RWLOCK_HPP */
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+#include <limits.h>
+
+#include <vcrtos/cpu.h>
+
+#include "core/instance.hpp"
+#include "core/sema.hpp"
+#include "core/thread.hpp"
+
+namespace vc {
+
+void Sema::destroy(void)
+{
+    unsigned state_irq = cpu_irq_disable();
+
+    state = SEMA_DESTROY;
+
+    if (queue.next == NULL)
+    {
+        cpu_irq_restore(state_irq);
+        return;
+    }
+
+    /* Note: waiters keep wait_data pointing to this semaphore, which tells
+     * them they were canceled and not granted */
+
+    uint8_t priority = KERNEL_THREAD_PRIORITY_IDLE;
+
+    List *next;
+
+    while ((next = (static_cast<List *>(&queue))->remove_head()) != NULL)
+    {
+        Thread *thread = Thread::get_thread_pointer_from_list_member(next);
+
+        get<ThreadScheduler>().set_thread_status(thread, THREAD_STATUS_PENDING);
+
+        if (thread->get_priority() < priority)
+        {
+            priority = thread->get_priority();
+        }
+    }
+
+    cpu_irq_restore(state_irq);
+
+    get<ThreadScheduler>().context_switch(priority);
+}
+
+int Sema::post(void)
+{
+    unsigned state_irq = cpu_irq_disable();
+
+    if (queue.next)
+    {
+        /* Note: hand the token directly to the highest priority waiter, value
+         * stays at zero so no other thread can steal it in between */
+
+        List *next = (static_cast<List *>(&queue))->remove_head();
+
+        Thread *thread = Thread::get_thread_pointer_from_list_member(next);
+
+        uint8_t thread_priority = TimedWait::wake(get<ThreadScheduler>(), thread);
+
+        cpu_irq_restore(state_irq);
+
+        get<ThreadScheduler>().context_switch(thread_priority);
+
+        return 0;
+    }
+
+    if (value == UINT_MAX)
+    {
+        cpu_irq_restore(state_irq);
+        return -EOVERFLOW;
+    }
+
+    value++;
+
+    cpu_irq_restore(state_irq);
+
+    return 0;
+}
+
+kernel_pid_t Sema::peek(void)
+{
+    unsigned state_irq = cpu_irq_disable();
+
+    if (queue.next == NULL)
+    {
+        cpu_irq_restore(state_irq);
+        return KERNEL_PID_UNDEF;
+    }
+
+    Thread *thread = Thread::get_thread_pointer_from_list_member(static_cast<List *>(queue.next));
+
+    cpu_irq_restore(state_irq);
+
+    return thread->get_pid();
+}
+
+int Sema::set_wait(int blocking, uint32_t timeout, WaitTimeout *wait_timeout)
+{
+    unsigned state_irq = cpu_irq_disable();
+
+    if (state != SEMA_OK)
+    {
+        cpu_irq_restore(state_irq);
+        return -ECANCELED;
+    }
+
+    if (value > 0)
+    {
+        value--;
+        cpu_irq_restore(state_irq);
+        return 0;
+    }
+
+    if (!blocking)
+    {
+        cpu_irq_restore(state_irq);
+        return -EAGAIN;
+    }
+
+    int result = TimedWait::wait(get<ThreadScheduler>(), static_cast<List *>(&queue), THREAD_STATUS_SEMA_BLOCKED,
+                                 static_cast<void *>(this), timeout, wait_timeout, static_cast<void *>(this),
+                                 remove_waiter, state_irq);
+
+    /* a waiter that was not granted the token got canceled or expired */
+
+    return (result != 0 && state != SEMA_OK) ? -ECANCELED : result;
+}
+
+int Sema::remove_waiter(void *owner, Thread *thread)
+{
+    Sema *sema = static_cast<Sema *>(owner);
+
+    return TimedWait::remove(sema->get<ThreadScheduler>(), static_cast<List *>(&sema->queue), thread);
+}
+
+template <> inline Instance &Sema::get(void) const
+{
+    return get_instance();
+}
+
+template <typename Type> inline Type &Sema::get(void) const
+{
+    return get_instance().get<Type>();
+}
+
+} // namespace vc
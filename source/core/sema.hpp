@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_SEMA_HPP
+#define CORE_SEMA_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/sema.h>
+#include <vcrtos/thread.h>
+#include <vcrtos/ztimer.h>
+
+#include "core/list.hpp"
+#include "core/timed_wait.hpp"
+
+namespace vc {
+
+class Instance;
+class Thread;
+
+#if !VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+extern uint64_t instance_raw[];
+#endif
+
+class Sema : public sema_t
+{
+public:
+    explicit Sema(Instance &instance, unsigned int initial_value)
+    {
+        init(instance, initial_value);
+    }
+
+    void init(Instance &instances, unsigned int initial_value)
+    {
+        queue.next = NULL;
+        value = initial_value;
+        state = SEMA_OK;
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+        instance = static_cast<void *>(&instances);
+#else
+        (void)instances;
+#endif
+    }
+
+    void destroy(void);
+
+    int post(void);
+
+    int wait(void) { return set_wait(1, 0, NULL); }
+
+    int try_wait(void) { return set_wait(0, 0, NULL); }
+
+    int wait_timed(uint32_t timeout)
+    {
+        WaitTimeout wait_timeout;
+        return wait_timed(timeout, &wait_timeout);
+    }
+
+    int wait_timed(uint32_t timeout, WaitTimeout *wait_timeout)
+    {
+        return set_wait(1, timeout, wait_timeout);
+    }
+
+    unsigned int get_value(void) const { return value; }
+
+    kernel_pid_t peek(void);
+
+private:
+    int set_wait(int blocking, uint32_t timeout, WaitTimeout *wait_timeout);
+
+    static int remove_waiter(void *owner, Thread *thread);
+
+    template <typename Type> inline Type &get(void) const;
+
+#if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
+    Instance &get_instance(void) const { return *static_cast<Instance *>(instance); }
+#else
+    Instance &get_instance(void) const { return *reinterpret_cast<Instance *>(&instance_raw); }
+#endif
+};
+
+} // namespace vc
+
+#endif /* CORE_SEMA_HPP */
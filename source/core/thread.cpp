@@ -116,6 +116,14 @@ Thread *Thread::init(Instance &instances, char *stack, int size, unsigned priori
 
     tcb->set_priority(priority);
 
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+    tcb->base_priority = priority;
+#endif
+
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+    tcb->get<ThreadScheduler>().set_msg_isr_queue(pid, NULL);
+#endif
+
     tcb->set_status(THREAD_STATUS_STOPPED);
 
     tcb->init_runqueue_entry();
@@ -192,7 +200,55 @@ void Thread::init_msg_queue(Msg *msg, int num)
 {
     msg_array = msg;
     (static_cast<Cib *>(&msg_queue))->init(num);
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    msg_prio_queue = NULL;
+#endif
+}
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+void Thread::init_msg_queue(Msg *msg, int num, msg_prio_queue_t *prio_queue)
+{
+    /* Note: every band gets num / VCRTOS_CONFIG_MSG_PRIORITY_BANDS slots, which
+     * has to be a power of two */
+
+    vcassert(num % VCRTOS_CONFIG_MSG_PRIORITY_BANDS == 0);
+
+    msg_array = msg;
+    (static_cast<Cib *>(&msg_queue))->init(0);
+    msg_prio_queue = prio_queue;
+
+    for (unsigned int band = 0; band < VCRTOS_CONFIG_MSG_PRIORITY_BANDS; band++)
+    {
+        get_msg_band_cib(band)->init(num / VCRTOS_CONFIG_MSG_PRIORITY_BANDS);
+    }
+}
+
+unsigned int Thread::get_msg_band(Msg *msg)
+{
+    unsigned int msg_priority = msg->priority;
+
+    if (msg_priority == MSG_PRIORITY_AUTO)
+    {
+        if (msg->sender_pid == KERNEL_PID_ISR)
+        {
+            msg_priority = 0;
+        }
+        else
+        {
+            Thread *sender = get<ThreadScheduler>().get_thread_from_scheduler(msg->sender_pid);
+
+            msg_priority = (sender != NULL) ? sender->get_priority() : KERNEL_THREAD_PRIORITY_MIN;
+        }
+    }
+
+    if (msg_priority > KERNEL_THREAD_PRIORITY_MIN)
+    {
+        msg_priority = KERNEL_THREAD_PRIORITY_MIN;
+    }
+
+    return msg_priority * VCRTOS_CONFIG_MSG_PRIORITY_BANDS / KERNEL_THREAD_PRIORITY_LEVELS;
 }
+#endif
 
 int Thread::has_msg_queue(void)
 {
@@ -206,38 +262,308 @@ int Thread::get_numof_msg_in_queue(void)
     if (has_msg_queue())
     {
         queued_msgs = (static_cast<Cib *>(&msg_queue))->avail();
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+        if (msg_prio_queue != NULL)
+        {
+            for (unsigned int band = 0; band < VCRTOS_CONFIG_MSG_PRIORITY_BANDS; band++)
+            {
+                queued_msgs += get_msg_band_cib(band)->avail();
+            }
+        }
+#endif
     }
 
     return queued_msgs;
 }
 
+int Thread::get_msg_queue_size(void)
+{
+    if (!has_msg_queue())
+    {
+        return 0;
+    }
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    if (msg_prio_queue != NULL)
+    {
+        return VCRTOS_CONFIG_MSG_PRIORITY_BANDS * (get_msg_band_cib(0)->get_mask() + 1);
+    }
+#endif
+
+    return (static_cast<Cib *>(&msg_queue))->get_mask() + 1;
+}
+
 int Thread::is_pid_valid(kernel_pid_t pid)
 {
     return ((KERNEL_PID_FIRST <= pid) && (pid <= KERNEL_PID_LAST));
 }
 
+int Thread::is_awaiting_reply(const Msg *msg)
+{
+    if (get_status() != THREAD_STATUS_REPLY_BLOCKED)
+    {
+        return 0;
+    }
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE || VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE
+    /* Note: a request the thread gave up on, e.g. by a timeout, may still be
+     * answered while it already waits for the reply of its next call, and an
+     * asynchronous request is not answered into a call */
+
+    return static_cast<Msg *>(wait_data)->correlation_id == msg->correlation_id;
+#else
+    (void)msg;
+    return 1;
+#endif
+}
+
 int Thread::queued_msg(Msg *msg)
 {
-    int index = (static_cast<Cib *>(&msg_queue))->put();
+    Cib *cib = static_cast<Cib *>(&msg_queue);
+
+    unsigned int offset = 0;
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    if (msg_prio_queue != NULL)
+    {
+        unsigned int band = get_msg_band(msg);
+
+        cib = get_msg_band_cib(band);
+        offset = band * (cib->get_mask() + 1);
+    }
+#endif
+
+    int index = cib->put();
+
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+    if (index < 0)
+    {
+        index = get_msg_overflow_index(cib, offset, msg);
+    }
+#endif
+
+    if (index < 0)
+    {
+        return 0;
+    }
+
+    Msg *dest = static_cast<Msg *>(&msg_array[offset + index]);
+
+    dest->copy(*msg);
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    if (msg_queue_stats != NULL)
+    {
+        msg_queue_stats->enqueued++;
+
+        int queued_msgs = get_numof_msg_in_queue();
+
+        if (queued_msgs > msg_queue_stats->high_water)
+        {
+            msg_queue_stats->high_water = static_cast<uint16_t>(queued_msgs);
+        }
+    }
+#endif
+
+    return 1;
+}
+
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+int Thread::get_msg_overflow_index(Cib *cib, unsigned int offset, Msg *msg)
+{
+    if (cib->get_mask() + 1 == 0)
+    {
+        return -1;
+    }
+
+    switch (msg_queue_policy)
+    {
+    case MSG_QUEUE_POLICY_DROP_OLDEST:
+        if (!is_msg_discardable(static_cast<Msg *>(&msg_array[offset + (cib->get_read_count() & cib->get_mask())])))
+        {
+            return -1;
+        }
+
+        (void)cib->get();
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+        if (msg_queue_stats != NULL)
+        {
+            msg_queue_stats->dropped++;
+        }
+#endif
+        return cib->put();
+
+    case MSG_QUEUE_POLICY_OVERWRITE:
+        for (unsigned int count = cib->get_write_count(); count != cib->get_read_count(); count--)
+        {
+            int index = static_cast<int>((count - 1) & cib->get_mask());
+
+            if (msg_array[offset + index].type == msg->type)
+            {
+                if (!is_msg_discardable(static_cast<Msg *>(&msg_array[offset + index])))
+                {
+                    return -1;
+                }
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+                if (msg_queue_stats != NULL)
+                {
+                    msg_queue_stats->overwritten++;
+                }
+#endif
+                return index;
+            }
+        }
+        return -1;
+
+    default:
+        return -1;
+    }
+}
+
+int Thread::is_msg_discardable(Msg *msg)
+{
+    /* Note: the client of a request would stay reply blocked forever */
+
+    if (!is_pid_valid(msg->sender_pid))
+    {
+        return 1;
+    }
+
+    Thread *sender_thread = get<ThreadScheduler>().get_thread_from_scheduler(msg->sender_pid);
+
+    return sender_thread == NULL || !sender_thread->is_awaiting_reply(msg);
+}
+#endif
+
+int Thread::dequeue_msg(Msg *msg)
+{
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    if (msg_prio_queue != NULL)
+    {
+        for (unsigned int band = 0; band < VCRTOS_CONFIG_MSG_PRIORITY_BANDS; band++)
+        {
+            Cib *cib = get_msg_band_cib(band);
+
+            int index = cib->get();
+
+            if (index >= 0)
+            {
+                msg->copy(*static_cast<Msg *>(&msg_array[band * (cib->get_mask() + 1) + index]));
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+                if (msg_queue_stats != NULL)
+                {
+                    msg_queue_stats->dequeued++;
+                }
+#endif
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+#endif
+
+    int index = (static_cast<Cib *>(&msg_queue))->get();
 
     if (index < 0)
     {
         return 0;
     }
 
-    Msg *dest = static_cast<Msg *>(&msg_array[index]);
+    msg->copy(*static_cast<Msg *>(&msg_array[index]));
 
-    *dest = *msg;
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    if (msg_queue_stats != NULL)
+    {
+        msg_queue_stats->dequeued++;
+    }
+#endif
 
     return 1;
 }
 
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+int Thread::dequeue_msg_filtered(Msg *msg, const MsgFilter *filter, unsigned int &budget)
+{
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    if (msg_prio_queue != NULL)
+    {
+        for (unsigned int band = 0; band < VCRTOS_CONFIG_MSG_PRIORITY_BANDS && budget > 0; band++)
+        {
+            Cib *cib = get_msg_band_cib(band);
+
+            if (dequeue_msg_filtered(cib, band * (cib->get_mask() + 1), msg, filter, budget))
+            {
+                return 1;
+            }
+        }
+
+        return 0;
+    }
+#endif
+
+    return dequeue_msg_filtered(static_cast<Cib *>(&msg_queue), 0, msg, filter, budget);
+}
+
+int Thread::dequeue_msg_filtered(Cib *cib, unsigned int offset, Msg *msg, const MsgFilter *filter,
+                                 unsigned int &budget)
+{
+    unsigned int mask = cib->get_mask();
+
+    for (unsigned int count = cib->get_read_count(); count != cib->get_write_count() && budget > 0; count++)
+    {
+        budget--;
+
+        Msg *queued = static_cast<Msg *>(&msg_array[offset + (count & mask)]);
+
+        if (!filter->matches(*queued))
+        {
+            continue;
+        }
+
+        msg->copy(*queued);
+
+        /* close the gap by moving the older msgs up one slot, the queue
+         * order stays the same */
+        for (; count != cib->get_read_count(); count--)
+        {
+            static_cast<Msg *>(&msg_array[offset + (count & mask)])
+                ->copy(*static_cast<Msg *>(&msg_array[offset + ((count - 1) & mask)]));
+        }
+
+        (void)cib->get_unsafe();
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+        if (msg_queue_stats != NULL)
+        {
+            msg_queue_stats->dequeued++;
+        }
+#endif
+
+        return 1;
+    }
+
+    return 0;
+}
+#endif
+
 void Thread::init_msg(void)
 {
     wait_data = NULL;
     msg_waiters.next = NULL;
     (static_cast<Cib *>(&msg_queue))->init(0);
     msg_array = NULL;
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    msg_prio_queue = NULL;
+#endif
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+    msg_queue_policy = MSG_QUEUE_POLICY_BLOCK;
+#endif
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    msg_queue_stats = NULL;
+#endif
 }
 
 #if VCRTOS_CONFIG_THREAD_FLAGS_ENABLE
@@ -320,6 +646,153 @@ void ThreadScheduler::set_thread_status(Thread *thread, thread_status_t status)
     thread->set_status(status);
 }
 
+void ThreadScheduler::set_thread_priority(Thread *thread, uint8_t priority)
+{
+    uint8_t old_priority = thread->get_priority();
+
+    if (old_priority == priority)
+    {
+        return;
+    }
+
+    if (thread->get_status() >= THREAD_STATUS_RUNNING)
+    {
+        Clist *entry = static_cast<Clist *>(thread->get_runqueue_entry());
+
+        scheduler_runqueue[old_priority].remove(entry);
+
+        if (scheduler_runqueue[old_priority].next == NULL)
+        {
+            reset_runqueue_bitcache(old_priority);
+        }
+
+        thread->set_priority(priority);
+
+        /* Note: the active thread has to stay at the head of its runqueue,
+         * set_thread_status() pops it from there when it blocks */
+
+        if (thread == get_current_active_thread())
+        {
+            scheduler_runqueue[priority].left_push(entry);
+        }
+        else
+        {
+            scheduler_runqueue[priority].right_push(entry);
+        }
+
+        set_runqueue_bitcache(priority);
+    }
+    else
+    {
+        /* Note: a thread waiting in a priority sorted list keeps its place */
+        thread->set_priority(priority);
+    }
+}
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+void ThreadScheduler::add_reply_pending(Thread *server, Thread *client)
+{
+    client->add_to_list(get_reply_pending(server->get_pid()));
+
+    msg_reply_servers[client->get_pid()] = server->get_pid();
+
+    update_inherited_priority(server);
+}
+
+void ThreadScheduler::remove_reply_pending(Thread *client)
+{
+    kernel_pid_t server_pid = msg_reply_servers[client->get_pid()];
+
+    if (server_pid == KERNEL_PID_UNDEF)
+    {
+        return;
+    }
+
+    msg_reply_servers[client->get_pid()] = KERNEL_PID_UNDEF;
+
+    List::remove(get_reply_pending(server_pid), static_cast<List *>(client->get_runqueue_entry()));
+
+    if (scheduled_threads[server_pid] != NULL)
+    {
+        update_inherited_priority(scheduled_threads[server_pid]);
+    }
+}
+
+void ThreadScheduler::update_inherited_priority(Thread *server)
+{
+    uint8_t priority = server->get_base_priority();
+
+    List *pending = static_cast<List *>(get_reply_pending(server->get_pid())->next);
+
+    /* both lists are sorted by priority, only the first client counts */
+
+    if (pending != NULL)
+    {
+        Thread *client = Thread::get_thread_pointer_from_list_member(pending);
+
+        if (client->get_priority() < priority)
+        {
+            priority = client->get_priority();
+        }
+    }
+
+    for (List *node = static_cast<List *>(server->msg_waiters.next); node != NULL;
+         node = static_cast<List *>(node->next))
+    {
+        Thread *sender = Thread::get_thread_pointer_from_list_member(node);
+
+        if (sender->get_status() == THREAD_STATUS_REPLY_BLOCKED)
+        {
+            if (sender->get_priority() < priority)
+            {
+                priority = sender->get_priority();
+            }
+
+            break;
+        }
+    }
+
+    set_thread_priority(server, priority);
+}
+#endif
+
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+void ThreadScheduler::deliver_msg_isr_queues(void)
+{
+    if (!__atomic_exchange_n(&msg_isr_pending, 0, __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+
+    /* Note: a nested isr pushing meanwhile sets the flag again and delivers
+     * from its own cpu_end_of_isr() */
+
+    unsigned state = cpu_irq_disable();
+
+    for (kernel_pid_t pid = KERNEL_PID_FIRST; pid <= KERNEL_PID_LAST; ++pid)
+    {
+        MsgIsrQueue *queue = msg_isr_queues[pid];
+
+        if (queue == NULL || !queue->test_and_clear_pending())
+        {
+            continue;
+        }
+
+        Thread *thread = scheduled_threads[pid];
+
+        if (thread != NULL && thread->get_status() == THREAD_STATUS_RECEIVE_BLOCKED &&
+            queue->pop(static_cast<Msg *>(thread->wait_data)))
+        {
+            set_thread_status(thread, THREAD_STATUS_PENDING);
+
+            enable_context_switch_request();
+        }
+    }
+
+    cpu_irq_restore(state);
+}
+#endif
+
 void ThreadScheduler::context_switch(uint8_t priority_to_switch)
 {
     Thread *current_thread = get_current_active_thread();
@@ -515,6 +988,26 @@ const char *ThreadScheduler::thread_status_to_string(thread_status_t status)
         retval = "bl flags";
         break;
 
+    case THREAD_STATUS_MBOX_BLOCKED:
+        retval = "bl mbox";
+        break;
+
+    case THREAD_STATUS_COND_BLOCKED:
+        retval = "bl cond";
+        break;
+
+    case THREAD_STATUS_SEMA_BLOCKED:
+        retval = "bl sema";
+        break;
+
+    case THREAD_STATUS_RWLOCK_BLOCKED:
+        retval = "bl rwlock";
+        break;
+
+    case THREAD_STATUS_RECEIVE_FILTERED_BLOCKED:
+        retval = "bl rx filter";
+        break;
+
     default:
         retval = "unknown";
         break;
@@ -676,42 +1169,98 @@ void EventQueue::event_post(Event *event, Thread *thread)
 
     unsigned state = cpu_irq_disable();
 
-    if (!event->list_node.next)
+    if (!event->is_queued())
+    {
+        get_event_list()->right_push(static_cast<Dlist *>(&event->list_node));
+        numof_events++;
+    }
+
+    /* Note: in coalescing mode the event thread is only signaled once, as
+     * long as THREAD_FLAG_EVENT is still set the pending wakeup will also
+     * pick up this event */
+
+    bool wakeup = !coalesce || !(thread->flags & THREAD_FLAG_EVENT);
+
+#if VCRTOS_CONFIG_THREAD_EVENT_STATS_ENABLE
+    stats.posts++;
+
+    if (wakeup)
     {
-        (static_cast<Clist *>(&event_list))->right_push(static_cast<Clist *>(&event->list_node));
+        stats.wakeups++;
     }
+#endif
 
     cpu_irq_restore(state);
 
-    get<ThreadScheduler>().thread_flags_set(thread, THREAD_FLAG_EVENT);
+    if (wakeup)
+    {
+        get<ThreadScheduler>().thread_flags_set(thread, THREAD_FLAG_EVENT);
+    }
 }
 
 void EventQueue::event_cancel(Event *event)
 {
     vcassert(event);
 
+    /* Note: the event must be queued in this event queue (or not queued at
+     * all), removing is constant time and does not search the queue. An event
+     * of another queue can only be caught when it's alone in its list. */
+
     unsigned state = cpu_irq_disable();
 
-    (static_cast<Clist *>(&event_list))->remove(static_cast<Clist *>(&event->list_node));
+    if (event->is_queued())
+    {
+        vcassert(numof_events > 0);
+        vcassert(event->list_node.next != &event->list_node || event_list.next == &event->list_node);
+
+        get_event_list()->remove(static_cast<Dlist *>(&event->list_node));
+        numof_events--;
 
-    event->list_node.next = NULL;
+        /* Note: whether the event was claimed by a batch is not known, the
+         * batch always gives up one claim. If the event was not claimed the
+         * last claimed event is left to the queue, still in order. */
+
+        if (numof_batched > 0)
+        {
+            numof_batched--;
+        }
+    }
+
+    event_release(event);
 
     cpu_irq_restore(state);
 }
 
+Event *EventQueue::event_pop(void)
+{
+    Event *result = reinterpret_cast<Event *>(get_event_list()->left_pop());
+
+    if (result)
+    {
+        numof_events--;
+
+        if (numof_batched > 0)
+        {
+            numof_batched--;
+        }
+
+        event_release(result);
+#if VCRTOS_CONFIG_THREAD_EVENT_STATS_ENABLE
+        stats.events++;
+#endif
+    }
+
+    return result;
+}
+
 Event *EventQueue::event_get(void)
 {
     unsigned state = cpu_irq_disable();
 
-    Event *result = reinterpret_cast<Event *>((static_cast<Clist *>(&event_list))->left_pop());
+    Event *result = event_pop();
 
     cpu_irq_restore(state);
 
-    if (result)
-    {
-        result->list_node.next = NULL;
-    }
-
     return result;
 }
 
@@ -722,7 +1271,7 @@ Event *EventQueue::event_wait(void)
 #ifdef UNITTEST
 
     unsigned state = cpu_irq_disable();
-    result = reinterpret_cast<Event *>((static_cast<Clist *>(&event_list))->left_pop());
+    result = event_pop();
     cpu_irq_restore(state);
 
     if (result == NULL)
@@ -735,7 +1284,7 @@ Event *EventQueue::event_wait(void)
     do
     {
         unsigned state = cpu_irq_disable();
-        result = reinterpret_cast<Event *>((static_cast<Clist *>(&event_list))->left_pop());
+        result = event_pop();
         cpu_irq_restore(state);
 
         if (result == NULL)
@@ -750,28 +1299,129 @@ Event *EventQueue::event_wait(void)
     return result;
 }
 
+void EventQueue::event_loop(void)
+{
+    Event *event;
+
+    /* Note: event_wait() only returns NULL on unittest build, on real device
+     * this loop never exit */
+
+    while ((event = event_wait()) != NULL)
+    {
+        vcassert(event->handler != NULL);
+
+        event->handler(event);
+    }
+}
+
+unsigned EventQueue::event_get_batch(EventBatch *batch)
+{
+    vcassert(batch && batch->is_empty());
+
+    unsigned state = cpu_irq_disable();
+
+    unsigned count = numof_events - numof_batched;
+
+    /* Note: the events are only claimed, they stay in the queue list and
+     * stay marked as queued until handed out by the batch, so claiming is
+     * constant time and posting them again in the meantime has no effect */
+
+    numof_batched = numof_events;
+    batch->queue = this;
+
+    cpu_irq_restore(state);
+
+    return count;
+}
+
+unsigned EventQueue::event_wait_batch(EventBatch *batch)
+{
+    unsigned count = 0;
+
+#ifdef UNITTEST
+
+    count = event_get_batch(batch);
+
+    if (count == 0)
+    {
+        get<ThreadScheduler>().thread_flags_wait_any(THREAD_FLAG_EVENT);
+    }
+
+#else
+
+    do
+    {
+        count = event_get_batch(batch);
+
+        if (count == 0)
+        {
+            get<ThreadScheduler>().thread_flags_wait_any(THREAD_FLAG_EVENT);
+        }
+
+    } while (count == 0);
+
+#endif
+
+    return count;
+}
+
+Event *EventQueue::event_get_batched(void)
+{
+    Event *result = NULL;
+
+    /* Note: claimed events are always the oldest in the queue */
+
+    unsigned state = cpu_irq_disable();
+
+    if (numof_batched > 0)
+    {
+        result = event_pop();
+    }
+
+    cpu_irq_restore(state);
+
+    return result;
+}
+
+Event *EventBatch::event_get(void)
+{
+    if (queue == NULL)
+    {
+        return NULL;
+    }
+
+    return static_cast<EventQueue *>(queue)->event_get_batched();
+}
+
 void EventQueue::event_release(Event *event)
 {
     /* Note: before releasing the event, make sure it's no longer in the event_queue */
     event->list_node.next = NULL;
+    event->list_node.prev = NULL;
 }
 
 int EventQueue::event_pending(void)
 {
-    return (static_cast<Clist *>(&event_list))->count();
+    return static_cast<int>(numof_events);
 }
 
 Event *EventQueue::event_peek(void)
 {
-    return reinterpret_cast<Event *>((static_cast<Clist *>(&event_list))->left_peek());
+    return reinterpret_cast<Event *>(get_event_list()->left_peek());
 }
 
 #endif // #if VCRTOS_CONFIG_THREAD_EVENT_ENABLE
 
 extern "C" void cpu_end_of_isr(void)
 {
+    /* Note: with multiple instances there is no instance to look at, msg
+     * send_in_isr() delivers isr queue msgs itself then */
+
 #if !VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
     Instance &instance = *static_cast<Instance *>(instance_get());
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+    instance.get<ThreadScheduler>().deliver_msg_isr_queues();
+#endif
     if (instance.get<ThreadScheduler>().is_context_switch_requested())
     {
         ThreadScheduler::yield_higher_priority_thread();
@@ -30,6 +30,7 @@
 #include "core/msg.hpp"
 #include "core/cib.hpp"
 #include "core/clist.hpp"
+#include "core/dlist.hpp"
 
 namespace vc {
 
@@ -58,6 +59,10 @@ public:
 
     void set_priority(uint8_t new_priority) { priority = new_priority; }
 
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+    uint8_t get_base_priority(void) { return base_priority; }
+#endif
+
     list_node_t *get_runqueue_entry(void) { return &runqueue_entry; }
 
     const char *get_name(void) { return name; }
@@ -70,17 +75,77 @@ public:
 
     void init_msg_queue(Msg *msg, int num);
 
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    void init_msg_queue(Msg *msg, int num, msg_prio_queue_t *prio_queue);
+#endif
+
     int queued_msg(Msg *msg);
 
+    int dequeue_msg(Msg *msg);
+
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+    /* Take the oldest queued msg matching filter, budget is decremented for
+     * every msg looked at */
+    int dequeue_msg_filtered(Msg *msg, const MsgFilter *filter, unsigned int &budget);
+#endif
+
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+    void set_msg_queue_policy(msg_queue_policy_t policy) { msg_queue_policy = static_cast<uint8_t>(policy); }
+
+    msg_queue_policy_t get_msg_queue_policy(void) const { return static_cast<msg_queue_policy_t>(msg_queue_policy); }
+
+    /* full queue either blocks the sender or makes the send fail */
+    int is_msg_queue_blocking(void) const { return msg_queue_policy == MSG_QUEUE_POLICY_BLOCK; }
+#endif
+
+#if VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE
+    void set_msg_queue_stats(msg_queue_stats_t *stats)
+    {
+        msg_queue_stats = stats;
+        reset_msg_queue_stats();
+    }
+
+    msg_queue_stats_t *get_msg_queue_stats(void) const { return msg_queue_stats; }
+
+    void reset_msg_queue_stats(void)
+    {
+        if (msg_queue_stats != NULL)
+        {
+            memset(msg_queue_stats, 0, sizeof(*msg_queue_stats));
+        }
+    }
+#endif
+
     int get_numof_msg_in_queue(void);
 
+    int get_msg_queue_size(void);
+
     int has_msg_queue(void);
 
+    /* thread is still blocked in the send_receive() call msg belongs to */
+    int is_awaiting_reply(const Msg *msg);
+
 private:
     void init_runqueue_entry(void) { runqueue_entry.next = NULL; }
 
     void init_msg(void);
 
+#if VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE
+    int get_msg_overflow_index(Cib *cib, unsigned int offset, Msg *msg);
+
+    int is_msg_discardable(Msg *msg);
+#endif
+
+#if VCRTOS_CONFIG_MSG_FILTER_ENABLE
+    int dequeue_msg_filtered(Cib *cib, unsigned int offset, Msg *msg, const MsgFilter *filter, unsigned int &budget);
+#endif
+
+#if VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE
+    unsigned int get_msg_band(Msg *msg);
+
+    Cib *get_msg_band_cib(unsigned int band) { return static_cast<Cib *>(&msg_prio_queue->bands[band]); }
+#endif
+
 #if VCRTOS_CONFIG_THREAD_FLAGS_ENABLE
     void init_flags(void);
 #endif
@@ -111,7 +176,28 @@ public:
     Event(void)
     {
         list_node.next = NULL;
+        list_node.prev = NULL;
+        handler = NULL;
     }
+
+    explicit Event(event_handler_func_t func)
+    {
+        list_node.next = NULL;
+        list_node.prev = NULL;
+        handler = func;
+    }
+
+    int is_queued(void) const { return list_node.next != NULL; }
+};
+
+class EventBatch : public event_batch_t
+{
+public:
+    EventBatch(void) { queue = NULL; }
+
+    Event *event_get(void);
+
+    int is_empty(void) const { return queue == NULL || queue->numof_batched == 0; }
 };
 
 class EventQueue : public event_queue_t
@@ -120,6 +206,13 @@ public:
     explicit EventQueue(Instance &instances)
     {
         event_list.next = NULL;
+        event_list.prev = NULL;
+        numof_events = 0;
+        numof_batched = 0;
+        coalesce = 0;
+#if VCRTOS_CONFIG_THREAD_EVENT_STATS_ENABLE
+        reset_stats();
+#endif
 #if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
         instance = static_cast<void *>(&instances);
 #else
@@ -135,13 +228,45 @@ public:
 
     Event *event_wait(void);
 
+    void event_loop(void);
+
     static void event_release(Event *event);
 
     int event_pending(void);
 
     Event *event_peek(void);
 
+    void set_coalesce(bool enable) { coalesce = enable ? 1 : 0; }
+
+    bool is_coalesce(void) const { return coalesce != 0; }
+
+    unsigned event_get_batch(EventBatch *batch);
+
+    unsigned event_wait_batch(EventBatch *batch);
+
+    Event *event_get_batched(void);
+
+#if VCRTOS_CONFIG_THREAD_EVENT_STATS_ENABLE
+    const event_queue_stats_t &get_stats(void) const { return stats; }
+
+    void reset_stats(void)
+    {
+        stats.posts = 0;
+        stats.wakeups = 0;
+        stats.events = 0;
+    }
+
+    unsigned get_events_per_wakeup(void) const
+    {
+        return (stats.wakeups != 0) ? (stats.events / stats.wakeups) : 0;
+    }
+#endif
+
 private:
+    Dlist *get_event_list(void) { return static_cast<Dlist *>(&event_list); }
+
+    Event *event_pop(void);
+
     template <typename Type> inline Type &get(void) const;
 
 #if VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE
@@ -165,8 +290,29 @@ public:
         for (kernel_pid_t i = KERNEL_PID_FIRST; i <= KERNEL_PID_LAST; ++i)
         {
             scheduled_threads[i] = NULL;
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+            msg_futures[i].next = NULL;
+#endif
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+            msg_reply_pending[i].next = NULL;
+            msg_reply_servers[i] = KERNEL_PID_UNDEF;
+#endif
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+            msg_isr_queues[i] = NULL;
+#endif
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+            msg_buf_outstanding[i] = 0;
+#endif
         }
 
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+        msg_isr_pending = 0;
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE || VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE
+        msg_correlation_id = 0;
+#endif
+
         instance = static_cast<void *>(&instances);
     }
 
@@ -202,6 +348,9 @@ public:
 
     void set_thread_status(Thread *thread, thread_status_t status);
 
+    /* Move thread to another priority, a runnable thread changes runqueue */
+    void set_thread_priority(Thread *thread, uint8_t priority);
+
     void context_switch(uint8_t priority_to_switch);
 
     void sleeping_current_thread(void);
@@ -230,6 +379,61 @@ public:
     int thread_flags_wake(Thread *thread);
 #endif
 
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+    /* Note: server got the request of the reply blocked client, it runs at
+     * least at the client priority until it replied */
+    void add_reply_pending(Thread *server, Thread *client);
+
+    /* Take client off the reply pending list of the server that got its
+     * request, if any */
+    void remove_reply_pending(Thread *client);
+
+    /* Recalculate the inherited priority of server from its reply pending
+     * clients and the reply blocked clients waiting in its msg_waiters */
+    void update_inherited_priority(Thread *server);
+
+    List *get_reply_pending(kernel_pid_t pid) { return static_cast<List *>(&msg_reply_pending[pid]); }
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+    List *get_msg_futures(kernel_pid_t pid) { return static_cast<List *>(&msg_futures[pid]); }
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE || VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE
+    uint16_t get_next_msg_correlation_id(void)
+    {
+        /* 0 marks a plain msg */
+        if (++msg_correlation_id == 0)
+        {
+            msg_correlation_id++;
+        }
+
+        return msg_correlation_id;
+    }
+#endif
+
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+    MsgIsrQueue *get_msg_isr_queue(kernel_pid_t pid) { return msg_isr_queues[pid]; }
+
+    void set_msg_isr_queue(kernel_pid_t pid, MsgIsrQueue *queue) { msg_isr_queues[pid] = queue; }
+
+    /* called from isr after a push, the delivery is left to cpu_end_of_isr() */
+    void request_msg_isr_delivery(void) { __atomic_store_n(&msg_isr_pending, 1, __ATOMIC_RELEASE); }
+
+    /* Hand the next isr queue msg to every receive blocked owner of a pending
+     * queue, requests a context switch when one got woken up */
+    void deliver_msg_isr_queues(void);
+#endif
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+    /* msg buffers charged to pid that are not released yet */
+    unsigned int get_msg_buf_outstanding(kernel_pid_t pid) { return msg_buf_outstanding[pid]; }
+
+    void charge_msg_buf(kernel_pid_t pid) { msg_buf_outstanding[pid]++; }
+
+    void uncharge_msg_buf(kernel_pid_t pid) { msg_buf_outstanding[pid]--; }
+#endif
+
 private:
     uint32_t get_runqueue_bitcache(void) { return runqueue_bitcache; }
 
@@ -267,6 +471,30 @@ private:
 
     scheduler_stat_t scheduler_stats[KERNEL_PID_LAST + 1];
 
+#if VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE
+    list_node_t msg_reply_pending[KERNEL_PID_LAST + 1];
+
+    kernel_pid_t msg_reply_servers[KERNEL_PID_LAST + 1];
+#endif
+
+#if VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE
+    MsgIsrQueue *msg_isr_queues[KERNEL_PID_LAST + 1];
+
+    uint8_t msg_isr_pending;
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE
+    list_node_t msg_futures[KERNEL_PID_LAST + 1];
+#endif
+
+#if VCRTOS_CONFIG_MSG_BUF_DEBUG
+    uint16_t msg_buf_outstanding[KERNEL_PID_LAST + 1];
+#endif
+
+#if VCRTOS_CONFIG_MSG_ASYNC_ENABLE || VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE
+    uint16_t msg_correlation_id;
+#endif
+
     void *instance;
 };
 
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+
+#include <vcrtos/cpu.h>
+
+#include "core/thread.hpp"
+#include "core/timed_wait.hpp"
+
+namespace vc {
+
+Thread *TimedWait::enqueue(ThreadScheduler &scheduler, List *queue, thread_status_t status, void *data,
+                           uint32_t timeout, WaitTimeout *wait_timeout, void *owner, wait_remove_func_t remove)
+{
+    Thread *current_thread = scheduler.get_current_active_thread();
+
+    scheduler.set_thread_status(current_thread, status);
+
+    current_thread->wait_data = data;
+
+    current_thread->add_to_list(queue);
+
+    if (timeout != 0)
+    {
+        wait_timeout->scheduler = &scheduler;
+        wait_timeout->thread = current_thread;
+        wait_timeout->owner = owner;
+        wait_timeout->remove = remove;
+        wait_timeout->status = status;
+        wait_timeout->timer.callback = handle_timeout;
+        wait_timeout->timer.arg = static_cast<void *>(wait_timeout);
+        ztimer_set(ZTIMER_USEC, &wait_timeout->timer, timeout);
+    }
+
+    return current_thread;
+}
+
+int TimedWait::sleep(Thread *thread, uint32_t timeout, WaitTimeout *wait_timeout, unsigned irqstate)
+{
+    cpu_irq_restore(irqstate);
+
+    ThreadScheduler::yield_higher_priority_thread();
+
+#ifndef UNITTEST
+    /* Note: on unittest build yield returns right away while the thread is
+     * still blocked, the timer stays armed so a test can expire it later */
+    if (timeout != 0)
+    {
+        ztimer_remove(ZTIMER_USEC, &wait_timeout->timer);
+    }
+#else
+    (void)timeout;
+    (void)wait_timeout;
+#endif
+
+    return (thread->wait_data == NULL) ? 0 : -ETIMEDOUT;
+}
+
+uint8_t TimedWait::wake(ThreadScheduler &scheduler, Thread *thread)
+{
+    thread->wait_data = NULL;
+
+    scheduler.set_thread_status(thread, THREAD_STATUS_PENDING);
+
+    return thread->get_priority();
+}
+
+int TimedWait::remove(ThreadScheduler &scheduler, List *queue, Thread *thread)
+{
+    if (List::remove(queue, static_cast<List *>(thread->get_runqueue_entry())) == NULL)
+    {
+        return -1;
+    }
+
+    scheduler.set_thread_status(thread, THREAD_STATUS_PENDING);
+
+    return thread->get_priority();
+}
+
+void TimedWait::handle_timeout(void *arg)
+{
+    WaitTimeout *wait_timeout = static_cast<WaitTimeout *>(arg);
+
+    int priority = -1;
+
+    unsigned state = cpu_irq_disable();
+
+    /* Note: the wait may already be completed by another thread */
+
+    if (wait_timeout->thread->get_status() == wait_timeout->status)
+    {
+        priority = wait_timeout->remove(wait_timeout->owner, wait_timeout->thread);
+    }
+
+    cpu_irq_restore(state);
+
+    if (priority >= 0)
+    {
+        wait_timeout->scheduler->context_switch(static_cast<uint8_t>(priority));
+    }
+}
+
+} // namespace vc
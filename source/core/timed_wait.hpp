@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_TIMED_WAIT_HPP
+#define CORE_TIMED_WAIT_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <vcrtos/config.h>
+#include <vcrtos/thread.h>
+#include <vcrtos/ztimer.h>
+
+#include "core/list.hpp"
+
+namespace vc {
+
+class Thread;
+class ThreadScheduler;
+
+/* Takes an expired waiter off the wait lists of owner, called with irq
+ * disabled, returns the priority to switch to or -1 when it was not queued */
+typedef int (*wait_remove_func_t)(void *owner, Thread *thread);
+
+/* Note: only used while the calling thread is blocked, passing it from the
+ * caller allows the waiter to be expired from outside */
+
+struct WaitTimeout
+{
+    ztimer_t timer;
+    ThreadScheduler *scheduler;
+    Thread *thread;
+    void *owner;
+    wait_remove_func_t remove;
+    thread_status_t status;
+};
+
+/* Blocking on a wait list with an optional timeout, shared by the primitives
+ * that hand over to a waiting thread directly. The waker clears wait_data of
+ * the thread it completes, a waiter that still has it set after being woken
+ * up was expired or canceled. */
+
+class TimedWait
+{
+public:
+    /* block the current thread on queue, timeout 0 waits forever. Called with
+     * irq disabled, returns the blocked thread */
+    static Thread *enqueue(ThreadScheduler &scheduler, List *queue, thread_status_t status, void *data,
+                           uint32_t timeout, WaitTimeout *wait_timeout, void *owner, wait_remove_func_t remove);
+
+    /* restore irqstate and yield, returns 0 when the waker completed the wait
+     * of thread, -ETIMEDOUT otherwise */
+    static int sleep(Thread *thread, uint32_t timeout, WaitTimeout *wait_timeout, unsigned irqstate);
+
+    static int wait(ThreadScheduler &scheduler, List *queue, thread_status_t status, void *data, uint32_t timeout,
+                    WaitTimeout *wait_timeout, void *owner, wait_remove_func_t remove, unsigned irqstate)
+    {
+        Thread *thread = enqueue(scheduler, queue, status, data, timeout, wait_timeout, owner, remove);
+        return sleep(thread, timeout, wait_timeout, irqstate);
+    }
+
+    /* complete the wait of a thread already taken off its queue, returns its
+     * priority */
+    static uint8_t wake(ThreadScheduler &scheduler, Thread *thread);
+
+    /* take thread off queue without completing its wait, returns its priority
+     * or -1 when it is not queued there */
+    static int remove(ThreadScheduler &scheduler, List *queue, Thread *thread);
+
+private:
+    static void handle_timeout(void *arg);
+};
+
+} // namespace vc
+
+#endif /* CORE_TIMED_WAIT_HPP */
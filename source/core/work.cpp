@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <vcrtos/assert.h>
+#include <vcrtos/cpu.h>
+#include <vcrtos/ztimer.h>
+
+#include "core/instance.hpp"
+#include "core/new.hpp"
+#include "core/work.hpp"
+
+#if VCRTOS_CONFIG_WORK_QUEUE_ENABLE
+
+namespace vc {
+
+WorkQueue::WorkQueue(Instance &instance)
+{
+    new (&event_queue) EventQueue(instance);
+    thread = NULL;
+}
+
+Work::Work(work_handler_func_t func)
+{
+    new (&super) Event(handle_event);
+    handler = func;
+    queue = NULL;
+    timer.base.next = NULL;
+    timer.base.offset = 0;
+    timer.callback = handle_timeout;
+    timer.arg = static_cast<void *>(this);
+    scheduled = 0;
+}
+
+void Work::post(void)
+{
+    WorkQueue *work_queue = get_queue();
+
+    vcassert(work_queue != NULL && work_queue->get_thread() != NULL);
+
+    /* Note: posting an event that is already queued is a no-op, the work item
+     * itself is the queue node so no allocation or copy is needed */
+
+    work_queue->get_event_queue().event_post(get_event(), work_queue->get_thread());
+}
+
+int Work::submit(WorkQueue *work_queue)
+{
+    vcassert(work_queue != NULL);
+
+    unsigned state = cpu_irq_disable();
+
+    if (is_queued())
+    {
+        cpu_irq_restore(state);
+        return 0;
+    }
+
+    if (is_scheduled())
+    {
+        /* delayed work is submitted now, the pending timeout is dropped */
+        ztimer_remove(ZTIMER_USEC, &timer);
+        scheduled = 0;
+    }
+
+    queue = work_queue;
+
+    /* Note: post while still masked, a cancel or submit from isr must never
+     * see the work neither pending nor queued */
+
+    post();
+
+    cpu_irq_restore(state);
+
+    return 1;
+}
+
+int Work::schedule(WorkQueue *work_queue, uint32_t delay)
+{
+    vcassert(work_queue != NULL);
+
+    if (delay == 0)
+    {
+        return submit(work_queue);
+    }
+
+    unsigned state = cpu_irq_disable();
+
+    if (is_pending())
+    {
+        /* keep the deadline of the work that is already pending */
+        cpu_irq_restore(state);
+        return 0;
+    }
+
+    queue = work_queue;
+    scheduled = 1;
+
+    ztimer_set(ZTIMER_USEC, &timer, delay);
+
+    cpu_irq_restore(state);
+
+    return 1;
+}
+
+int Work::reschedule(WorkQueue *work_queue, uint32_t delay)
+{
+    (void)cancel();
+
+    return schedule(work_queue, delay);
+}
+
+int Work::cancel(void)
+{
+    int canceled = 0;
+
+    unsigned state = cpu_irq_disable();
+
+    if (is_scheduled())
+    {
+        ztimer_remove(ZTIMER_USEC, &timer);
+        scheduled = 0;
+        canceled = 1;
+    }
+
+    if (is_queued())
+    {
+        get_queue()->get_event_queue().event_cancel(get_event());
+        canceled = 1;
+    }
+
+    cpu_irq_restore(state);
+
+    return canceled;
+}
+
+void Work::handle_event(event_t *event)
+{
+    Work *work = reinterpret_cast<Work *>(event);
+
+    vcassert(work->handler != NULL);
+
+    work->handler(work);
+}
+
+void Work::handle_timeout(void *arg)
+{
+    Work *work = static_cast<Work *>(arg);
+
+    /* Note: this is called from ztimer interrupt context */
+
+    work->scheduled = 0;
+
+    work->post();
+}
+
+} // namespace vc
+
+#endif // #if VCRTOS_CONFIG_WORK_QUEUE_ENABLE
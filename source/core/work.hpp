@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef CORE_WORK_HPP
+#define CORE_WORK_HPP
+
+#include <vcrtos/config.h>
+#include <vcrtos/work.h>
+
+#include "core/thread.hpp"
+
+#if VCRTOS_CONFIG_WORK_QUEUE_ENABLE
+
+#if !VCRTOS_CONFIG_THREAD_EVENT_ENABLE || !VCRTOS_CONFIG_THREAD_FLAGS_ENABLE
+#error "work queue require VCRTOS_CONFIG_THREAD_EVENT_ENABLE and VCRTOS_CONFIG_THREAD_FLAGS_ENABLE"
+#endif
+
+namespace vc {
+
+class Instance;
+
+class WorkQueue : public work_queue_t
+{
+public:
+    explicit WorkQueue(Instance &instance);
+
+    EventQueue &get_event_queue(void) { return *static_cast<EventQueue *>(&event_queue); }
+
+    Thread *get_thread(void) { return static_cast<Thread *>(thread); }
+
+    void set_thread(Thread *new_thread) { thread = new_thread; }
+
+    void run(void) { get_event_queue().event_loop(); }
+};
+
+class Work : public work_t
+{
+public:
+    explicit Work(work_handler_func_t func);
+
+    int submit(WorkQueue *work_queue);
+
+    int schedule(WorkQueue *work_queue, uint32_t delay);
+
+    int reschedule(WorkQueue *work_queue, uint32_t delay);
+
+    int cancel(void);
+
+    int is_pending(void) { return is_scheduled() || is_queued(); }
+
+    int is_scheduled(void) { return scheduled != 0; }
+
+    int is_queued(void) { return get_event()->is_queued(); }
+
+private:
+    WorkQueue *get_queue(void) { return static_cast<WorkQueue *>(queue); }
+
+    Event *get_event(void) { return static_cast<Event *>(&super); }
+
+    void post(void);
+
+    static void handle_event(event_t *event);
+
+    static void handle_timeout(void *arg);
+};
+
+} // namespace vc
+
+#endif // #if VCRTOS_CONFIG_WORK_QUEUE_ENABLE
+
+#endif /* CORE_WORK_HPP */
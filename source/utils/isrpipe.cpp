@@ -15,6 +15,8 @@
  * Authors: Darko Pancev <darko.pancev@vertexcom.com>
  */
 
+#include <errno.h>
+
 #include "core/instance.hpp"
 #include "utils/isrpipe.hpp"
 
@@ -24,18 +26,120 @@ namespace utils {
 Isrpipe::Isrpipe(Instance &instance, char *buf, unsigned int size)
     : _mutex(instance)
     , _tsrb(buf, size)
+    , _wakeup_threshold(1)
+    , _wakeup_delimiter(-1)
+    , _idle_timeout(0)
 {
+    _idle_timer.callback = handle_idle_timeout;
+    _idle_timer.arg = static_cast<void *>(this);
+
+    _read_timer.callback = handle_read_timeout;
+    _read_timer.arg = static_cast<void *>(this);
+    _read_timed_out = 0;
+
+    reset_stats();
 }
 
 int Isrpipe::write_one(char byte)
 {
     int res = get_tsrb().add_one(byte);
 
-    get_mutex().unlock();
+    if (res == 0)
+    {
+        _stats.bytes++;
+    }
+    else
+    {
+        _stats.dropped++;
+    }
+
+    if (res != 0 || is_wakeup_due(&byte, 1))
+    {
+        wakeup();
+    }
+    else
+    {
+        arm_idle_timer();
+    }
 
     return res;
 }
 
+int Isrpipe::write(const char *buf, size_t size)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    size_t written = get_tsrb().add(buf, size);
+
+    _stats.bytes += written;
+    _stats.dropped += size - written;
+
+    if (written < size || is_wakeup_due(buf, written))
+    {
+        wakeup();
+    }
+    else
+    {
+        arm_idle_timer();
+    }
+
+    return written;
+}
+
+void Isrpipe::set_idle_timeout(uint32_t idle_timeout)
+{
+    if (idle_timeout == 0)
+    {
+        ztimer_remove(ZTIMER_USEC, &_idle_timer);
+    }
+
+    _idle_timeout = idle_timeout;
+}
+
+int Isrpipe::is_wakeup_due(const char *buf, size_t size)
+{
+    if (static_cast<unsigned int>(get_tsrb().avail()) >= _wakeup_threshold || get_tsrb().is_full())
+    {
+        return 1;
+    }
+
+    return _wakeup_delimiter >= 0 && memchr(buf, static_cast<unsigned char>(_wakeup_delimiter), size) != NULL;
+}
+
+void Isrpipe::wakeup(void)
+{
+    if (_idle_timeout != 0)
+    {
+        ztimer_remove(ZTIMER_USEC, &_idle_timer);
+    }
+
+    _stats.wakeups++;
+
+    get_mutex().unlock();
+}
+
+void Isrpipe::arm_idle_timer(void)
+{
+    /* Note: every byte restarts the idle time */
+    if (_idle_timeout != 0)
+    {
+        ztimer_set(ZTIMER_USEC, &_idle_timer, _idle_timeout);
+    }
+}
+
+void Isrpipe::handle_idle_timeout(void *arg)
+{
+    Isrpipe *isrpipe = static_cast<Isrpipe *>(arg);
+
+    if (!isrpipe->get_tsrb().is_empty())
+    {
+        isrpipe->wakeup();
+    }
+}
+
 int Isrpipe::read(char *buf, size_t size)
 {
     int res;
@@ -55,6 +159,94 @@ int Isrpipe::read(char *buf, size_t size)
     return res;
 }
 
+int Isrpipe::read_timeout(char *buf, size_t size, uint32_t timeout)
+{
+    int res = get_tsrb().get(buf, size);
+
+    if (res != 0 || size == 0)
+    {
+        return res;
+    }
+
+    start_read_timer(timeout);
+
+#ifdef UNITTEST
+    if (!(res = get_tsrb().get(buf, size)) && !_read_timed_out)
+#else
+    while (!(res = get_tsrb().get(buf, size)) && !_read_timed_out)
+#endif
+    {
+        get_mutex().lock();
+    }
+
+    stop_read_timer(timeout);
+
+    return (res == 0) ? -ETIMEDOUT : res;
+}
+
+int Isrpipe::read_exact(char *buf, size_t size, uint32_t timeout)
+{
+    size_t done = get_tsrb().get(buf, size);
+
+    if (done == size)
+    {
+        return done;
+    }
+
+    start_read_timer(timeout);
+
+#ifdef UNITTEST
+    if ((done += get_tsrb().get(buf + done, size - done)) < size && !_read_timed_out)
+#else
+    while ((done += get_tsrb().get(buf + done, size - done)) < size && !_read_timed_out)
+#endif
+    {
+        get_mutex().lock();
+    }
+
+    stop_read_timer(timeout);
+
+    return done;
+}
+
+void Isrpipe::start_read_timer(uint32_t timeout)
+{
+    /* Note: drop a wakeup left behind by bytes that were read without
+     * waiting, the caller checks the pipe again before it blocks */
+    (void)get_mutex().try_lock();
+
+    _read_timed_out = 0;
+
+    if (timeout != 0)
+    {
+        ztimer_set(ZTIMER_USEC, &_read_timer, timeout);
+    }
+}
+
+void Isrpipe::stop_read_timer(uint32_t timeout)
+{
+#ifndef UNITTEST
+    /* Note: on unittest build lock returns right away while the reader is
+     * still blocked, the timer stays armed so a test can expire it later */
+    if (timeout != 0)
+    {
+        ztimer_remove(ZTIMER_USEC, &_read_timer);
+    }
+#else
+    (void)timeout;
+#endif
+}
+
+void Isrpipe::handle_read_timeout(void *arg)
+{
+    Isrpipe *isrpipe = static_cast<Isrpipe *>(arg);
+
+    /* Note: wakes the reader like a writer would, it sees the flag once the
+     * pipe is still empty */
+    isrpipe->_read_timed_out = 1;
+    isrpipe->get_mutex().unlock();
+}
+
 int Tsrb::get_one(void)
 {
     if (!is_empty())
@@ -67,30 +259,45 @@ int Tsrb::get_one(void)
     }
 }
 
+/* Note: the bulk functions read both counters once and update their own
+ * counter once at the end. The signal fences keep the compiler from moving
+ * the memcpy across the counter accesses, so an isr on the other side only
+ * ever sees fully copied bytes. */
+
 int Tsrb::get(char *buf, size_t size)
 {
-    size_t tmp = size;
+    unsigned int reads = _reads;
+    size_t count = _writes - reads;
+
+    __atomic_signal_fence(__ATOMIC_ACQUIRE);
 
-    while (tmp && !is_empty())
+    if (count > size)
     {
-        *buf++ = pop();
-        tmp--;
+        count = size;
     }
 
-    return (size - tmp);
+    copy_out(buf, reads, count);
+
+    __atomic_signal_fence(__ATOMIC_RELEASE);
+
+    _reads = reads + count;
+
+    return count;
 }
 
 int Tsrb::drop(size_t size)
 {
-    size_t tmp = size;
+    unsigned int reads = _reads;
+    size_t count = _writes - reads;
 
-    while (tmp && !is_empty())
+    if (count > size)
     {
-        pop();
-        tmp--;
+        count = size;
     }
 
-    return (size - tmp);
+    _reads = reads + count;
+
+    return count;
 }
 
 int Tsrb::add_one(char byte)
@@ -108,15 +315,63 @@ int Tsrb::add_one(char byte)
 
 int Tsrb::add(const char *buf, size_t size)
 {
-    size_t tmp = size;
+    unsigned int writes = _writes;
+    size_t count = _size - (writes - _reads);
 
-    while (tmp && !is_full())
+    __atomic_signal_fence(__ATOMIC_ACQUIRE);
+
+    if (count > size)
     {
-        push(*buf++);
-        tmp--;
+        count = size;
     }
 
-    return (size - tmp);
+    copy_in(buf, writes, count);
+
+    __atomic_signal_fence(__ATOMIC_RELEASE);
+
+    _writes = writes + count;
+
+    return count;
+}
+
+unsigned int Tsrb::write_reserve(RingSpan *span)
+{
+    unsigned int writes = _writes;
+
+    get_span(span, writes, _size - (writes - _reads));
+
+    __atomic_signal_fence(__ATOMIC_ACQUIRE);
+
+    return span->total();
+}
+
+void Tsrb::write_commit(unsigned int size)
+{
+    vcassert(size <= static_cast<unsigned int>(free()));
+
+    __atomic_signal_fence(__ATOMIC_RELEASE);
+
+    _writes = _writes + size;
+}
+
+unsigned int Tsrb::read_peek(RingSpan *span)
+{
+    unsigned int reads = _reads;
+
+    get_span(span, reads, _writes - reads);
+
+    __atomic_signal_fence(__ATOMIC_ACQUIRE);
+
+    return span->total();
+}
+
+void Tsrb::read_release(unsigned int size)
+{
+    vcassert(size <= static_cast<unsigned int>(avail()));
+
+    __atomic_signal_fence(__ATOMIC_RELEASE);
+
+    _reads = _reads + size;
 }
 
 } // namespace utils
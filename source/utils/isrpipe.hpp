@@ -19,12 +19,16 @@
 #define UTILS_ISRPIPPE_HPP
 
 #include <stdint.h>
+#include <string.h>
 
 #include <vcrtos/config.h>
 #include <vcrtos/assert.h>
+#include <vcrtos/ztimer.h>
 
 #include "core/mutex.hpp"
 
+#include "utils/ringbuffer.hpp"
+
 namespace vc {
 
 class Instance;
@@ -65,13 +69,68 @@ public:
 
     char pop(void) { return _buf[_reads++ & (_size - 1)]; }
 
+    /* Producer side zero-copy access, fill span in place and publish the
+     * written bytes with write_commit(), returns the free size */
+    unsigned int write_reserve(RingSpan *span);
+
+    void write_commit(unsigned int size);
+
+    /* Consumer side zero-copy access, the bytes in span stay valid until
+     * read_release(), returns the readable size */
+    unsigned int read_peek(RingSpan *span);
+
+    void read_release(unsigned int size);
+
 private:
+    void get_span(RingSpan *span, unsigned int position, unsigned int count) const
+    {
+        unsigned int offset = position & (_size - 1);
+
+        span->data[0] = &_buf[offset];
+        span->size[0] = (count < _size - offset) ? count : _size - offset;
+        span->data[1] = _buf;
+        span->size[1] = count - span->size[0];
+    }
+
+    /* copy count bytes starting at counter position, wrap-around takes a
+     * second memcpy */
+    void copy_out(char *buf, unsigned int position, size_t count) const
+    {
+        unsigned int offset = position & (_size - 1);
+        size_t first = (count < _size - offset) ? count : _size - offset;
+
+        memcpy(buf, &_buf[offset], first);
+        if (count > first)
+        {
+            memcpy(buf + first, _buf, count - first);
+        }
+    }
+
+    void copy_in(const char *buf, unsigned int position, size_t count)
+    {
+        unsigned int offset = position & (_size - 1);
+        size_t first = (count < _size - offset) ? count : _size - offset;
+
+        memcpy(&_buf[offset], buf, first);
+        if (count > first)
+        {
+            memcpy(_buf, buf + first, count - first);
+        }
+    }
+
     char *_buf;
     unsigned int _size;
     volatile unsigned _reads;
     volatile unsigned _writes;
 };
 
+struct IsrpipeStats
+{
+    uint32_t bytes;   /* bytes written into the pipe */
+    uint32_t dropped; /* bytes lost because the pipe was full */
+    uint32_t wakeups; /* times the reader got signalled */
+};
+
 class Isrpipe
 {
 public:
@@ -79,15 +138,64 @@ public:
 
     int write_one(char byte);
 
+    /* Bulk write from isr, signals the reader at most once, returns the
+     * number of bytes written */
+    int write(const char *buf, size_t size);
+
     int read(char *buf, size_t size);
 
+    /* Read up to size bytes, waits for at most timeout usec until the first
+     * byte arrived and returns -ETIMEDOUT when none did. A timeout of 0
+     * waits forever. */
+    int read_timeout(char *buf, size_t size, uint32_t timeout);
+
+    /* Read exactly size bytes within timeout usec, returns the number of
+     * bytes read, which is less than size when the time ran out. A timeout
+     * of 0 waits until all size bytes arrived. */
+    int read_exact(char *buf, size_t size, uint32_t timeout);
+
+    /* Wakeup policy, by default the reader is signalled on every byte. It
+     * is signalled once threshold bytes are buffered, on the delimiter byte
+     * (-1 disables it), when the pipe runs full, or once no byte arrived for
+     * idle_timeout usec (0 disables it). */
+    void set_wakeup_threshold(unsigned int threshold) { _wakeup_threshold = threshold ? threshold : 1; }
+
+    void set_wakeup_delimiter(int delimiter) { _wakeup_delimiter = delimiter; }
+
+    void set_idle_timeout(uint32_t idle_timeout);
+
+    const IsrpipeStats &get_stats(void) const { return _stats; }
+
+    void reset_stats(void) { memset(&_stats, 0, sizeof(_stats)); }
+
     Mutex &get_mutex(void) { return _mutex; }
 
     Tsrb &get_tsrb(void) { return _tsrb; }
 
 private:
+    int is_wakeup_due(const char *buf, size_t size);
+
+    void wakeup(void);
+
+    void arm_idle_timer(void);
+
+    static void handle_idle_timeout(void *arg);
+
+    void start_read_timer(uint32_t timeout);
+
+    void stop_read_timer(uint32_t timeout);
+
+    static void handle_read_timeout(void *arg);
+
     Mutex _mutex;
     Tsrb _tsrb;
+    unsigned int _wakeup_threshold;
+    int _wakeup_delimiter;
+    uint32_t _idle_timeout;
+    ztimer_t _idle_timer;
+    ztimer_t _read_timer;
+    volatile uint8_t _read_timed_out;
+    IsrpipeStats _stats;
 };
 
 class UartIsrpipe : public Isrpipe
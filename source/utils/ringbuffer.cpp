@@ -138,7 +138,7 @@ unsigned RingBuffer::remove(unsigned size)
         _avail -= size;
 
         /* compensate undeflow */
-        if (_start > _size)
+        if (_start >= _size)
         {
             _start -= _size;
         }
@@ -159,5 +159,43 @@ unsigned RingBuffer::peek(char *buf, unsigned size)
     return rb.get(buf, size);
 }
 
+unsigned RingBuffer::write_reserve(RingSpan *span)
+{
+    unsigned pos = _start + _avail;
+
+    if (pos >= _size)
+    {
+        pos -= _size;
+    }
+
+    unsigned bytes_till_end = _size - pos;
+
+    span->data[0] = _buf + pos;
+    span->size[0] = (free() < bytes_till_end) ? free() : bytes_till_end;
+    span->data[1] = _buf;
+    span->size[1] = free() - span->size[0];
+
+    return span->total();
+}
+
+void RingBuffer::write_commit(unsigned size)
+{
+    vcassert(size <= free());
+
+    _avail += size;
+}
+
+unsigned RingBuffer::read_peek(RingSpan *span)
+{
+    unsigned bytes_till_end = _size - _start;
+
+    span->data[0] = _buf + _start;
+    span->size[0] = (_avail < bytes_till_end) ? _avail : bytes_till_end;
+    span->data[1] = _buf;
+    span->size[1] = _avail - span->size[0];
+
+    return span->total();
+}
+
 } // namespace utils
 } // namespace vc
@@ -19,10 +19,21 @@
 #define UTILS_RINGBUFFER_HPP
 
 #include <vcrtos/config.h>
+#include <vcrtos/assert.h>
 
 namespace vc {
 namespace utils {
 
+/* Up to two contiguous regions of ring storage, the second one holds the
+ * part wrapping around the end of the buffer */
+struct RingSpan
+{
+    char *data[2];
+    unsigned int size[2];
+
+    unsigned int total(void) const { return size[0] + size[1]; }
+};
+
 class RingBuffer
 {
 public:
@@ -56,6 +67,18 @@ public:
 
     unsigned peek(char *buf, unsigned size);
 
+    /* Free storage to write into in place, e.g. by DMA, returns its size.
+     * Nothing becomes readable until write_commit(). */
+    unsigned write_reserve(RingSpan *span);
+
+    void write_commit(unsigned size);
+
+    /* Readable bytes in place, returns their number. They stay in the
+     * buffer until read_release(). */
+    unsigned read_peek(RingSpan *span);
+
+    unsigned read_release(unsigned size) { return remove(size); }
+
 private:
     void add_tail(char byte);
 
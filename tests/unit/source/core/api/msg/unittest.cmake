@@ -7,12 +7,14 @@ set(unittest-sources
     ../../source/core/mutex.cpp
     ../../source/core/msg.cpp
     ../../source/core/assert_failure.c
+    ../../source/ztimer/core.c
     ../../source/core/api/mutex_api.cpp
     ../../source/core/api/msg_api.cpp
     ../../source/core/api/thread_api.cpp
     stubs/cpu_stub.c
     stubs/thread_stub.c
     stubs/thread_arch_stub.c
+    stubs/ztimer_stub.c
 )
 
 set(unittest-test-sources
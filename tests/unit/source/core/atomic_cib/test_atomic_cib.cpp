@@ -0,0 +1,289 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <stdio.h>
+
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "core/atomic_cib.hpp"
+#include "core/cib.hpp"
+
+using namespace vc;
+
+class TestAtomicCib : public testing::Test
+{
+protected:
+    AtomicCib<4> *obj;
+
+    virtual void SetUp()
+    {
+        obj = new AtomicCib<4>();
+    }
+
+    virtual void TearDown()
+    {
+        delete obj;
+    }
+};
+
+TEST_F(TestAtomicCib, constructor_test)
+{
+    EXPECT_TRUE(obj);
+}
+
+TEST_F(TestAtomicCib, functions_test)
+{
+    EXPECT_EQ(obj->full(), 0);
+    EXPECT_EQ(obj->avail(), 0);
+    EXPECT_EQ(obj->get_mask(), 3);
+
+    EXPECT_EQ(obj->peek(), -1);
+    EXPECT_EQ(obj->get(), -1);
+
+    for (int i = 0; i < 4; i++)
+    {
+        int index = obj->put();
+        EXPECT_EQ(index, i);
+        obj->commit_put(index);
+    }
+
+    EXPECT_EQ(obj->put(), -1); /* cib already full */
+    EXPECT_EQ(obj->full(), 1);
+    EXPECT_EQ(obj->avail(), 4);
+
+    EXPECT_EQ(obj->peek(), 0);
+
+    int index = obj->get();
+    EXPECT_EQ(index, 0);
+
+    /* slot 0 is not released yet */
+    EXPECT_EQ(obj->put(), -1);
+
+    obj->commit_get(index);
+
+    index = obj->put();
+    EXPECT_EQ(index, 0);
+
+    /* reserved but not published, consumers stop in front of it */
+    for (int i = 1; i < 4; i++)
+    {
+        int got = obj->get();
+        EXPECT_EQ(got, i);
+        obj->commit_get(got);
+    }
+
+    EXPECT_EQ(obj->peek(), -1);
+    EXPECT_EQ(obj->get(), -1);
+
+    obj->commit_put(index);
+
+    EXPECT_EQ(obj->peek(), 0);
+    EXPECT_EQ(obj->get(), 0);
+
+    obj->init();
+
+    EXPECT_EQ(obj->avail(), 0);
+    EXPECT_EQ(obj->put(), 0);
+}
+
+/* Cib used the way the kernel does with interrupts masked, on the host a
+ * mutex stands in for cpu_irq_disable() */
+
+class IrqMaskedCib
+{
+public:
+    IrqMaskedCib(void)
+        : cib(64)
+    {
+    }
+
+    int push(unsigned int value)
+    {
+        std::lock_guard<std::mutex> lock(irq);
+
+        int index = cib.put();
+
+        if (index < 0)
+        {
+            return 0;
+        }
+
+        slots[index] = value;
+
+        return 1;
+    }
+
+    int pop(unsigned int &value)
+    {
+        std::lock_guard<std::mutex> lock(irq);
+
+        int index = cib.get();
+
+        if (index < 0)
+        {
+            return 0;
+        }
+
+        value = slots[index];
+
+        return 1;
+    }
+
+private:
+    std::mutex irq;
+    Cib cib;
+    unsigned int slots[64];
+};
+
+class LockFreeCib
+{
+public:
+    int push(unsigned int value)
+    {
+        int index = cib.put();
+
+        if (index < 0)
+        {
+            return 0;
+        }
+
+        slots[index] = value;
+
+        cib.commit_put(index);
+
+        return 1;
+    }
+
+    int pop(unsigned int &value)
+    {
+        int index = cib.get();
+
+        if (index < 0)
+        {
+            return 0;
+        }
+
+        value = slots[index];
+
+        cib.commit_get(index);
+
+        return 1;
+    }
+
+private:
+    AtomicCib<64> cib;
+    unsigned int slots[64];
+};
+
+template <typename Queue>
+static std::chrono::nanoseconds run_contention(Queue &queue, int numof_producers, int numof_consumers,
+                                               unsigned int per_producer, unsigned long long &sum)
+{
+    std::vector<std::thread> threads;
+    std::vector<unsigned long long> sums(numof_consumers, 0);
+
+    const unsigned int total = per_producer * numof_producers;
+    std::atomic<unsigned int> consumed(0);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int p = 0; p < numof_producers; p++)
+    {
+        threads.push_back(std::thread([&queue, per_producer]() {
+            for (unsigned int i = 1; i <= per_producer; i++)
+            {
+                while (!queue.push(i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    for (int c = 0; c < numof_consumers; c++)
+    {
+        threads.push_back(std::thread([&queue, &consumed, &sums, c, total]() {
+            unsigned int value;
+
+            while (consumed.load() < total)
+            {
+                if (queue.pop(value))
+                {
+                    sums[c] += value;
+                    consumed++;
+                }
+                else
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+    sum = 0;
+
+    for (auto value : sums)
+    {
+        sum += value;
+    }
+
+    return elapsed;
+}
+
+TEST_F(TestAtomicCib, contention_benchmark_test)
+{
+    const int numof_producers = 4;
+    const int numof_consumers = 4;
+    const unsigned int per_producer = 50000;
+
+    /* every producer sends 1..per_producer, nothing may get lost or doubled */
+    const unsigned long long expected = numof_producers * (static_cast<unsigned long long>(per_producer) *
+                                                           (per_producer + 1) / 2);
+
+    const double total = static_cast<double>(numof_producers) * per_producer;
+
+    unsigned long long sum;
+
+    IrqMaskedCib masked;
+
+    std::chrono::nanoseconds masked_time = run_contention(masked, numof_producers, numof_consumers,
+                                                          per_producer, sum);
+
+    EXPECT_EQ(sum, expected);
+
+    LockFreeCib lock_free;
+
+    std::chrono::nanoseconds lock_free_time = run_contention(lock_free, numof_producers, numof_consumers,
+                                                             per_producer, sum);
+
+    EXPECT_EQ(sum, expected);
+
+    printf("[ BENCHMARK] cib irq masked : %.2f Mops/s\n", total / masked_time.count() * 1000.0);
+    printf("[ BENCHMARK] cib atomic     : %.2f Mops/s\n", total / lock_free_time.count() * 1000.0);
+}
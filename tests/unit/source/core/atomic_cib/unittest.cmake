@@ -0,0 +1,13 @@
+set(unittest-includes ${unittest-includes}
+)
+
+set(unittest-sources
+    ../../source/core/assert_failure.c
+)
+
+set(unittest-test-sources
+    source/core/atomic_cib/test_atomic_cib.cpp
+)
+
+set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DVCRTOS_PROJECT_CONFIG_FILE='\"vcrtos-unittest-config.h\"'")
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DVCRTOS_PROJECT_CONFIG_FILE='\"vcrtos-unittest-config.h\"'")
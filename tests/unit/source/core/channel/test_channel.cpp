@@ -0,0 +1,315 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+
+#include "gtest/gtest.h"
+
+#include "core/channel.hpp"
+#include "core/instance.hpp"
+#include "core/thread.hpp"
+
+#include "test-threads.hpp"
+
+using namespace vc;
+
+/* move only element counting its moves and live objects */
+
+struct Token
+{
+    static int alive;
+
+    int value;
+    int moves;
+
+    Token(void)
+        : value(0)
+        , moves(0)
+    {
+        alive++;
+    }
+
+    explicit Token(int token_value)
+        : value(token_value)
+        , moves(0)
+    {
+        alive++;
+    }
+
+    Token(Token &&other)
+        : value(other.value)
+        , moves(other.moves + 1)
+    {
+        other.value = -1;
+        alive++;
+    }
+
+    Token &operator=(Token &&other)
+    {
+        value = other.value;
+        moves = other.moves + 1;
+        other.value = -1;
+        return *this;
+    }
+
+    Token(const Token &) = delete;
+
+    Token &operator=(const Token &) = delete;
+
+    ~Token(void) { alive--; }
+};
+
+int Token::alive = 0;
+
+class TestChannel : public TestThreads
+{
+protected:
+    virtual void SetUp()
+    {
+        TestThreads::SetUp();
+
+        instance->get<ThreadScheduler>().run();
+    }
+};
+
+
+TEST_F(TestChannel, constructor_test)
+{
+    EXPECT_TRUE(instance);
+
+    Channel<Token, 4> channel(*instance);
+
+    EXPECT_EQ(channel.size(), 4);
+    EXPECT_EQ(channel.avail(), 0);
+    EXPECT_GE(sizeof(channel), 4 * sizeof(Token));
+}
+
+TEST_F(TestChannel, try_send_recv_test)
+{
+    Token::alive = 0;
+
+    {
+        Channel<Token, 2> channel(*instance);
+
+        Token item;
+
+        EXPECT_EQ(channel.try_recv(item), -EAGAIN);
+
+        /**
+         * ------------------------------------------------------------------------------
+         * [TEST CASE] elements are moved once in and once out in FIFO order
+         * ------------------------------------------------------------------------------
+         **/
+
+        EXPECT_EQ(channel.try_send(Token(1)), 0);
+        EXPECT_EQ(channel.try_send(Token(2)), 0);
+        EXPECT_EQ(channel.try_send(Token(3)), -EAGAIN);
+        EXPECT_EQ(channel.avail(), 2);
+        EXPECT_EQ(Token::alive, 3); /* item plus two queued */
+
+        EXPECT_EQ(channel.try_recv(item), 0);
+        EXPECT_EQ(item.value, 1);
+        EXPECT_EQ(item.moves, 2);
+
+        EXPECT_EQ(channel.try_recv(item), 0);
+        EXPECT_EQ(item.value, 2);
+        EXPECT_EQ(channel.try_recv(item), -EAGAIN);
+        EXPECT_EQ(Token::alive, 1);
+
+        /* elements left in the channel are destroyed with it */
+
+        EXPECT_EQ(channel.try_send(Token(4)), 0);
+        EXPECT_EQ(Token::alive, 2);
+    }
+
+    EXPECT_EQ(Token::alive, 0);
+}
+
+TEST_F(TestChannel, blocking_recv_test)
+{
+    Channel<Token, 2> channel(*instance);
+
+    Token task2_item;
+    Token task1_item;
+
+    /* task2 and task1 wait on the empty channel */
+
+    channel.recv(task2_item);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    channel.recv(task1_item);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] send hands the element straight to the highest priority receiver
+     * ------------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(channel.send(Token(0x11)), 0);
+
+    EXPECT_EQ(channel.avail(), 0);
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+    EXPECT_EQ(task2_item.value, 0x11);
+    EXPECT_EQ(task2_item.moves, 1);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    /* send from ISR never blocks */
+
+    test_helper_set_cpu_in_isr();
+
+    EXPECT_EQ(channel.send(Token(0x22)), 0);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_item.value, 0x22);
+
+    EXPECT_EQ(channel.send(Token(0x33)), 0);
+    EXPECT_EQ(channel.send(Token(0x44)), 0);
+    EXPECT_EQ(channel.send(Token(0x55)), -EAGAIN);
+    EXPECT_EQ(channel.avail(), 2);
+
+    test_helper_reset_cpu_in_isr();
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+}
+
+TEST_F(TestChannel, blocking_send_test)
+{
+    Channel<Token, 1> channel(*instance);
+
+    Token task2_item = Token(2);
+    Token task1_item = Token(1);
+
+    EXPECT_EQ(channel.send(Token(0)), 0);
+
+    /* channel is full, task2 and task1 block on send */
+
+    channel.send(static_cast<Token &&>(task2_item));
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    channel.send(static_cast<Token &&>(task1_item));
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] each recv moves the element of the highest priority sender in
+     * ------------------------------------------------------------------------------
+     **/
+
+    Token item;
+
+    EXPECT_EQ(channel.recv(item), 0);
+    EXPECT_EQ(item.value, 0);
+    EXPECT_EQ(channel.avail(), 1);
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_item.value, -1); /* moved from */
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    EXPECT_EQ(channel.recv(item), 0);
+    EXPECT_EQ(item.value, 2);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+
+    EXPECT_EQ(channel.recv(item), 0);
+    EXPECT_EQ(item.value, 1);
+    EXPECT_EQ(channel.avail(), 0);
+}
+
+TEST_F(TestChannel, timeout_test)
+{
+    Channel<Token, 2> channel(*instance);
+
+    Token task1_item;
+    Token task2_item;
+
+    WaitTimeout timeout1;
+    WaitTimeout timeout2;
+
+    channel.recv_timeout(task2_item, 1000, &timeout2);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    channel.recv_timeout(task1_item, 500, &timeout1);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] expired receiver is removed from the channel
+     * ------------------------------------------------------------------------------
+     **/
+
+    test_helper_ztimer_advance(500);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->wait_data, &task1_item);
+
+    EXPECT_EQ(channel.send(Token(0x55)), 0);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_item.value, 0x55);
+
+    test_helper_ztimer_advance(500);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+    EXPECT_EQ(channel.avail(), 0);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] zero timeout waits until an item arrives
+     * ------------------------------------------------------------------------------
+     **/
+
+    Token task3_item;
+
+    channel.recv_timeout(task3_item, 0);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    test_helper_ztimer_advance(1000000);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    EXPECT_EQ(channel.send(Token(0xaa)), 0);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task3_thread->wait_data, nullptr);
+    EXPECT_EQ(task3_item.value, 0xaa);
+}
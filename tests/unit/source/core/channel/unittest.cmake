@@ -0,0 +1,23 @@
+set(unittest-includes ${unittest-includes}
+)
+
+set(unittest-sources
+    ../../source/core/instance.cpp
+    ../../source/core/thread.cpp
+    ../../source/core/timed_wait.cpp
+    ../../source/core/mutex.cpp
+    ../../source/core/channel.cpp
+    ../../source/core/assert_failure.c
+    ../../source/ztimer/core.c
+    stubs/cpu_stub.c
+    stubs/thread_stub.c
+    stubs/thread_arch_stub.c
+    stubs/ztimer_stub.c
+)
+
+set(unittest-test-sources
+    source/core/channel/test_channel.cpp
+)
+
+set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DVCRTOS_PROJECT_CONFIG_FILE='\"vcrtos-unittest-config.h\"'")
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DVCRTOS_PROJECT_CONFIG_FILE='\"vcrtos-unittest-config.h\"'")
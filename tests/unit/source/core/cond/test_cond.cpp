@@ -0,0 +1,332 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include "gtest/gtest.h"
+
+#include "core/cond.hpp"
+#include "core/instance.hpp"
+#include "core/mutex.hpp"
+#include "core/thread.hpp"
+
+#include "test-threads.hpp"
+
+using namespace vc;
+
+class TestCond : public TestThreads
+{
+protected:
+    virtual void SetUp()
+    {
+        TestThreads::SetUp();
+
+        instance->get<ThreadScheduler>().run();
+    }
+};
+
+TEST_F(TestCond, constructor_test)
+{
+    EXPECT_TRUE(instance);
+
+    Cond cond = Cond(*instance);
+
+    EXPECT_EQ(sizeof(Cond), sizeof(cond_t));
+    EXPECT_EQ(cond.queue.next, nullptr);
+}
+
+TEST_F(TestCond, wait_signal_test)
+{
+    Cond cond = Cond(*instance);
+    Mutex mutex = Mutex(*instance);
+
+    /* signal without waiter is lost */
+
+    cond.signal();
+    cond.broadcast();
+
+    EXPECT_EQ(cond.queue.next, nullptr);
+
+    /* task2, task1 and task3 wait on the condition */
+
+    mutex.lock();
+    cond.wait(&mutex);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+    EXPECT_EQ(mutex.queue.next, nullptr); /* mutex released */
+
+    instance->get<ThreadScheduler>().run();
+
+    mutex.lock();
+    cond.wait(&mutex);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    mutex.lock();
+    cond.wait(&mutex);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(mutex.queue.next, nullptr);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] signal with unlocked mutex hand it to the highest priority waiter
+     * ------------------------------------------------------------------------------
+     **/
+
+    cond.signal();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+    EXPECT_EQ(mutex.try_lock(), 0); /* owned by task2 */
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] signal with locked mutex move the waiter to the mutex queue
+     * ------------------------------------------------------------------------------
+     **/
+
+    cond.signal();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+
+    mutex.unlock();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+
+    sleep_and_run(task2_thread);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    mutex.unlock();
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+    EXPECT_EQ(mutex.queue.next, nullptr);
+}
+
+TEST_F(TestCond, broadcast_test)
+{
+    Cond cond = Cond(*instance);
+    Mutex mutex = Mutex(*instance);
+
+    mutex.lock();
+    cond.wait(&mutex);
+
+    instance->get<ThreadScheduler>().run();
+
+    mutex.lock();
+    cond.wait(&mutex);
+
+    instance->get<ThreadScheduler>().run();
+
+    mutex.lock();
+    cond.wait(&mutex);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] broadcast under the mutex wakes nobody before it is released
+     * ------------------------------------------------------------------------------
+     **/
+
+    mutex.lock();
+
+    cond.broadcast();
+
+    EXPECT_EQ(cond.queue.next, nullptr);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /* the waiters get the mutex one by one in priority order */
+
+    mutex.unlock();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    mutex.unlock();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    sleep_and_run(task2_thread);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    mutex.unlock();
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+
+    sleep_and_run(task1_thread);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    mutex.unlock();
+
+    EXPECT_EQ(mutex.queue.next, nullptr);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] broadcast without mutex held wakes only the first waiter
+     * ------------------------------------------------------------------------------
+     **/
+
+    wakeup_and_run(task2_thread);
+
+    mutex.lock();
+    cond.wait(&mutex);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    mutex.lock();
+    cond.wait(&mutex);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    cond.broadcast();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+}
+
+TEST_F(TestCond, wait_timed_test)
+{
+    Cond cond = Cond(*instance);
+    Mutex mutex = Mutex(*instance);
+
+    WaitTimeout timeout1;
+    WaitTimeout timeout2;
+
+    mutex.lock();
+    cond.wait_timed(&mutex, 1000, &timeout2);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    mutex.lock();
+    cond.wait_timed(&mutex, 500, &timeout1);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] expired waiter is removed from the condition
+     * ------------------------------------------------------------------------------
+     **/
+
+    test_helper_ztimer_advance(500);
+
+    /* Note: wait_timed() returns -ETIMEDOUT once the thread runs again with
+     * wait_data still set and 0 when it was cleared by signal() */
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->wait_data, &cond); /* not signaled */
+    EXPECT_EQ(mutex.queue.next, MUTEX_LOCKED); /* task1 owns the mutex again */
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] timeout after the waiter was signaled has no effect
+     * ------------------------------------------------------------------------------
+     **/
+
+    cond.signal();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+
+    test_helper_ztimer_advance(500);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+
+    mutex.unlock();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task2_thread);
+    EXPECT_EQ(mutex.queue.next, MUTEX_LOCKED); /* signaled waiter got the mutex handed over */
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] expired waiter waits for the mutex held by another thread
+     * ------------------------------------------------------------------------------
+     **/
+
+    cond.wait_timed(&mutex, 300, &timeout2);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_COND_BLOCKED);
+    EXPECT_EQ(mutex.queue.next, nullptr);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    mutex.lock();
+
+    test_helper_ztimer_advance(300);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+    EXPECT_EQ(task2_thread->wait_data, &cond);
+    EXPECT_EQ(cond.queue.next, nullptr);
+
+    mutex.unlock();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(mutex.queue.next, MUTEX_LOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task2_thread);
+    EXPECT_EQ(task2_thread->wait_data, &cond);
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include "gtest/gtest.h"
+
+#include "core/dlist.hpp"
+
+using namespace vc;
+
+class TestDlist : public testing::Test
+{
+protected:
+    Dlist *obj;
+
+    virtual void SetUp()
+    {
+        obj = new Dlist;
+    }
+
+    virtual void TearDown()
+    {
+        delete obj;
+    }
+};
+
+TEST_F(TestDlist, constructor_test)
+{
+    EXPECT_TRUE(obj);
+
+    EXPECT_EQ(sizeof(Dlist), sizeof(dlist_node_t));
+    EXPECT_TRUE(obj->is_empty());
+    EXPECT_EQ(obj->left_peek(), nullptr);
+    EXPECT_EQ(obj->right_peek(), nullptr);
+    EXPECT_EQ(obj->left_pop(), nullptr);
+    EXPECT_EQ(obj->right_pop(), nullptr);
+}
+
+TEST_F(TestDlist, right_push_test)
+{
+    Dlist node1;
+    Dlist node2;
+    Dlist node3;
+
+    obj->right_push(&node1);
+
+    /* obj->1, 1<->1 */
+
+    EXPECT_EQ(obj->next, &node1);
+    EXPECT_EQ(node1.next, &node1);
+    EXPECT_EQ(node1.prev, &node1);
+
+    obj->right_push(&node2);
+
+    /* obj->2, 1<->2<->1 */
+
+    EXPECT_EQ(obj->next, &node2);
+    EXPECT_EQ(node1.next, &node2);
+    EXPECT_EQ(node1.prev, &node2);
+    EXPECT_EQ(node2.next, &node1);
+    EXPECT_EQ(node2.prev, &node1);
+
+    obj->right_push(&node3);
+
+    /* obj->3, 1<->2<->3<->1 */
+
+    EXPECT_EQ(obj->next, &node3);
+    EXPECT_EQ(obj->left_peek(), &node1);
+    EXPECT_EQ(obj->right_peek(), &node3);
+    EXPECT_EQ(node1.next, &node2);
+    EXPECT_EQ(node2.next, &node3);
+    EXPECT_EQ(node3.next, &node1);
+    EXPECT_EQ(node1.prev, &node3);
+    EXPECT_EQ(node2.prev, &node1);
+    EXPECT_EQ(node3.prev, &node2);
+}
+
+TEST_F(TestDlist, left_push_test)
+{
+    Dlist node1;
+    Dlist node2;
+    Dlist node3;
+
+    obj->left_push(&node1);
+    obj->left_push(&node2);
+    obj->left_push(&node3);
+
+    /* obj->1, 3<->2<->1<->3 */
+
+    EXPECT_EQ(obj->next, &node1);
+    EXPECT_EQ(obj->left_peek(), &node3);
+    EXPECT_EQ(node3.next, &node2);
+    EXPECT_EQ(node2.next, &node1);
+    EXPECT_EQ(node1.next, &node3);
+    EXPECT_EQ(node3.prev, &node1);
+    EXPECT_EQ(node2.prev, &node3);
+    EXPECT_EQ(node1.prev, &node2);
+}
+
+TEST_F(TestDlist, pop_test)
+{
+    Dlist node1;
+    Dlist node2;
+    Dlist node3;
+    Dlist node4;
+
+    obj->right_push(&node1);
+    obj->right_push(&node2);
+    obj->right_push(&node3);
+    obj->right_push(&node4);
+
+    EXPECT_EQ(obj->left_pop(), &node1);
+    EXPECT_EQ(obj->right_pop(), &node4);
+
+    /* obj->3, 2<->3<->2 */
+
+    EXPECT_EQ(obj->next, &node3);
+    EXPECT_EQ(node2.next, &node3);
+    EXPECT_EQ(node2.prev, &node3);
+    EXPECT_EQ(node3.next, &node2);
+    EXPECT_EQ(node3.prev, &node2);
+
+    EXPECT_EQ(obj->left_pop(), &node2);
+    EXPECT_EQ(obj->left_pop(), &node3);
+    EXPECT_EQ(obj->left_pop(), nullptr);
+    EXPECT_TRUE(obj->is_empty());
+}
+
+TEST_F(TestDlist, remove_test)
+{
+    Dlist node1;
+    Dlist node2;
+    Dlist node3;
+    Dlist node4;
+
+    obj->right_push(&node1);
+    obj->right_push(&node2);
+    obj->right_push(&node3);
+    obj->right_push(&node4);
+
+    /* remove in the middle */
+
+    EXPECT_EQ(obj->remove(&node2), &node2);
+
+    EXPECT_EQ(obj->next, &node4);
+    EXPECT_EQ(node1.next, &node3);
+    EXPECT_EQ(node3.prev, &node1);
+
+    /* remove the last node, anchor move to the previous node */
+
+    EXPECT_EQ(obj->remove(&node4), &node4);
+
+    EXPECT_EQ(obj->next, &node3);
+    EXPECT_EQ(node3.next, &node1);
+    EXPECT_EQ(node1.prev, &node3);
+
+    /* remove the first node */
+
+    EXPECT_EQ(obj->remove(&node1), &node1);
+
+    EXPECT_EQ(obj->next, &node3);
+    EXPECT_EQ(node3.next, &node3);
+    EXPECT_EQ(node3.prev, &node3);
+
+    /* remove the only node */
+
+    EXPECT_EQ(obj->remove(&node3), &node3);
+
+    EXPECT_TRUE(obj->is_empty());
+
+    obj->right_push(&node2);
+
+    EXPECT_EQ(obj->left_peek(), &node2);
+    EXPECT_EQ(obj->right_peek(), &node2);
+}
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+
+#include "gtest/gtest.h"
+
+#include "core/instance.hpp"
+#include "core/mbox.hpp"
+#include "core/thread.hpp"
+
+#include "test-threads.hpp"
+
+using namespace vc;
+
+class TestMbox : public TestThreads
+{
+protected:
+    virtual void SetUp()
+    {
+        TestThreads::SetUp();
+
+        instance->get<ThreadScheduler>().run();
+    }
+};
+
+TEST_F(TestMbox, constructor_test)
+{
+    EXPECT_TRUE(instance);
+
+    Msg queue[4];
+
+    Mbox mbox = Mbox(*instance, queue, 4);
+
+    EXPECT_EQ(sizeof(Mbox), sizeof(mbox_t));
+    EXPECT_EQ(mbox.size(), 4);
+    EXPECT_EQ(mbox.avail(), 0);
+
+    Mbox rendezvous = Mbox(*instance, NULL, 0);
+
+    EXPECT_EQ(rendezvous.size(), 0);
+    EXPECT_EQ(rendezvous.avail(), 0);
+}
+
+TEST_F(TestMbox, try_put_get_test)
+{
+    Msg queue[2];
+
+    Mbox mbox = Mbox(*instance, queue, 2);
+
+    Msg msg1 = Msg(*instance);
+    Msg msg2 = Msg(*instance);
+    Msg msg3 = Msg(*instance);
+    Msg msg = Msg(*instance);
+
+    msg1.type = 1;
+    msg2.type = 2;
+    msg3.type = 3;
+
+    EXPECT_EQ(mbox.try_get(&msg), -EAGAIN);
+
+    EXPECT_EQ(mbox.try_put(&msg1), 0);
+    EXPECT_EQ(mbox.try_put(&msg2), 0);
+    EXPECT_EQ(mbox.try_put(&msg3), -EAGAIN); /* full */
+    EXPECT_EQ(mbox.avail(), 2);
+
+    EXPECT_EQ(mbox.try_get(&msg), 0);
+    EXPECT_EQ(msg.type, 1);
+    EXPECT_EQ(msg.sender_pid, task2_thread->get_pid());
+
+    EXPECT_EQ(mbox.get(&msg), 0);
+    EXPECT_EQ(msg.type, 2);
+
+    EXPECT_EQ(mbox.avail(), 0);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+}
+
+TEST_F(TestMbox, multiple_consumers_test)
+{
+    Msg queue[2];
+
+    Mbox mbox = Mbox(*instance, queue, 2);
+
+    Msg msg = Msg(*instance);
+    Msg task1_msg = Msg(*instance);
+    Msg task2_msg = Msg(*instance);
+    Msg task3_msg = Msg(*instance);
+
+    /* task2, task1 and task3 wait on the empty mailbox */
+
+    mbox.get(&task2_msg);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    mbox.get(&task1_msg);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    mbox.get(&task3_msg);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] each put is delivered to the highest priority waiting consumer
+     * ------------------------------------------------------------------------------
+     **/
+
+    msg.type = 0x11;
+
+    EXPECT_EQ(mbox.put(&msg), 0);
+
+    EXPECT_EQ(mbox.avail(), 0); /* delivered directly */
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+    EXPECT_EQ(task2_msg.type, 0x11);
+    EXPECT_EQ(task2_msg.sender_pid, main_thread->get_pid());
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    msg.type = 0x22;
+
+    EXPECT_EQ(mbox.try_put(&msg), 0);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_msg.type, 0x22);
+
+    /* put from ISR never blocks */
+
+    test_helper_set_cpu_in_isr();
+
+    msg.type = 0x33;
+
+    EXPECT_EQ(mbox.put(&msg), 0);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task3_msg.type, 0x33);
+    EXPECT_EQ(task3_msg.sender_pid, KERNEL_PID_ISR);
+
+    EXPECT_EQ(mbox.put(&msg), 0);
+    EXPECT_EQ(mbox.put(&msg), 0);
+    EXPECT_EQ(mbox.put(&msg), -EAGAIN);
+    EXPECT_EQ(mbox.avail(), 2);
+
+    test_helper_reset_cpu_in_isr();
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+}
+
+TEST_F(TestMbox, multiple_producers_test)
+{
+    Msg queue[2];
+
+    Mbox mbox = Mbox(*instance, queue, 2);
+
+    Msg msg = Msg(*instance);
+    Msg task1_msg = Msg(*instance);
+    Msg task2_msg = Msg(*instance);
+    Msg task3_msg = Msg(*instance);
+
+    task1_msg.type = 1;
+    task2_msg.type = 2;
+    task3_msg.type = 3;
+
+    EXPECT_EQ(mbox.put(&task2_msg), 0);
+    EXPECT_EQ(mbox.put(&task2_msg), 0);
+
+    /* mailbox is full, the next put blocks */
+
+    EXPECT_EQ(mbox.avail(), 2);
+
+    mbox.put(&task2_msg);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    mbox.put(&task1_msg);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    mbox.put(&task3_msg);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] each get let the highest priority waiting producer in
+     * ------------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(mbox.get(&msg), 0);
+
+    EXPECT_EQ(msg.type, 2);
+    EXPECT_EQ(mbox.avail(), 2);
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    EXPECT_EQ(mbox.get(&msg), 0);
+
+    EXPECT_EQ(msg.type, 2);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+
+    EXPECT_EQ(mbox.get(&msg), 0);
+
+    EXPECT_EQ(msg.type, 2); /* task2 message that was waiting */
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+
+    EXPECT_EQ(mbox.get(&msg), 0);
+    EXPECT_EQ(msg.type, 1);
+
+    EXPECT_EQ(mbox.get(&msg), 0);
+    EXPECT_EQ(msg.type, 3);
+
+    EXPECT_EQ(mbox.avail(), 0);
+}
+
+TEST_F(TestMbox, rendezvous_test)
+{
+    Mbox mbox = Mbox(*instance, NULL, 0);
+
+    Msg msg = Msg(*instance);
+    Msg task2_msg = Msg(*instance);
+
+    task2_msg.type = 0xaa;
+
+    EXPECT_EQ(mbox.try_put(&task2_msg), -EAGAIN);
+
+    mbox.put(&task2_msg);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(mbox.try_get(&msg), 0);
+    EXPECT_EQ(msg.type, 0xaa);
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+
+    EXPECT_EQ(mbox.try_get(&msg), -EAGAIN);
+}
+
+TEST_F(TestMbox, timeout_test)
+{
+    Msg queue[2];
+
+    Mbox mbox = Mbox(*instance, queue, 2);
+
+    Msg msg = Msg(*instance);
+    Msg task1_msg = Msg(*instance);
+    Msg task2_msg = Msg(*instance);
+
+    WaitTimeout timeout1;
+    WaitTimeout timeout2;
+
+    mbox.get_timeout(&task2_msg, 1000, &timeout2);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    mbox.get_timeout(&task1_msg, 500, &timeout1);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] expired consumer is removed from the mailbox
+     * ------------------------------------------------------------------------------
+     **/
+
+    test_helper_ztimer_advance(500);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->wait_data, &task1_msg); /* nothing received */
+
+    msg.type = 0x55;
+
+    EXPECT_EQ(mbox.put(&msg), 0);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_msg.type, 0x55);
+
+    /* timeout after the message was received has no effect */
+
+    test_helper_ztimer_advance(500);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+    EXPECT_EQ(mbox.avail(), 0);
+}
+
+TEST_F(TestMbox, zero_timeout_test)
+{
+    Msg queue[2];
+
+    Mbox mbox = Mbox(*instance, queue, 2);
+
+    Msg msg = Msg(*instance);
+    Msg task1_msg = Msg(*instance);
+    Msg task2_msg = Msg(*instance);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] consumer with zero timeout waits until a message arrives
+     * ------------------------------------------------------------------------------
+     **/
+
+    mbox.get_timeout(&task2_msg, 0);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    test_helper_ztimer_advance(1000000);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    msg.type = 0x55;
+
+    EXPECT_EQ(mbox.put(&msg), 0);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+    EXPECT_EQ(task2_msg.type, 0x55);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] producer with zero timeout waits until there is room
+     * ------------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(mbox.try_put(&msg), 0);
+    EXPECT_EQ(mbox.try_put(&msg), 0);
+
+    task1_msg.type = 0xaa;
+
+    mbox.put_timeout(&task1_msg, 0);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    test_helper_ztimer_advance(1000000);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_MBOX_BLOCKED);
+
+    EXPECT_EQ(mbox.get(&msg), 0);
+    EXPECT_EQ(msg.type, 0x55);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->wait_data, nullptr);
+    EXPECT_EQ(mbox.avail(), 2);
+}
@@ -15,6 +15,11 @@
  * Authors: Darko Pancev <darko.pancev@vertexcom.com>
  */
 
+#include <stdio.h>
+
+#include <chrono>
+#include <thread>
+
 #include "gtest/gtest.h"
 
 #include "core/instance.hpp"
@@ -820,3 +825,1844 @@ TEST_F(TestMsg, multiple_send_and_receive_msg_test)
 
     EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 0);
 }
+
+TEST_F(TestMsg, inline_payload_test)
+{
+    struct sample
+    {
+        uint32_t timestamp;
+        int16_t x;
+        int16_t y;
+        int16_t z;
+    };
+
+    EXPECT_TRUE(instance->is_initialized());
+
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+
+    Thread *idle_thread = Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(idle_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    Msg task1_msg_array[4];
+
+    for (int i = 0; i < 4; i++)
+    {
+        task1_msg_array[i].init(*instance);
+    }
+
+    task1_thread->init_msg_queue(task1_msg_array, ARRAY_LENGTH(task1_msg_array));
+
+    EXPECT_EQ(sizeof(Msg), sizeof(msg_t));
+    EXPECT_GE(sizeof(msg_t::content), VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] queue typed, raw and plain value payloads to sleeping task1
+     * -------------------------------------------------------------------------
+     **/
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    struct sample s1 = {0x12345678, -1, 2, -3};
+
+    Msg msg1 = Msg(*instance);
+    msg1.type = 0x1;
+    msg1.set_payload(s1);
+
+    EXPECT_EQ(msg1.get_payload_size(), sizeof(struct sample));
+
+    const uint8_t raw[] = {0xa1, 0xa2, 0xa3};
+
+    Msg msg2 = Msg(*instance);
+    msg2.type = 0x2;
+
+    EXPECT_EQ(msg2.set_payload(raw, sizeof(raw)), 0);
+    EXPECT_EQ(msg2.get_payload_size(), sizeof(raw));
+
+    uint8_t too_big[VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE + 1] = {0};
+
+    EXPECT_EQ(msg2.set_payload(too_big, sizeof(too_big)), -1);
+    EXPECT_EQ(msg2.get_payload_size(), sizeof(raw));
+
+    Msg msg3 = Msg(*instance);
+    msg3.type = 0x3;
+    msg3.content.value = 0xdeadbeef;
+
+    EXPECT_EQ(msg3.get_payload_size(), 0);
+
+    EXPECT_EQ(msg1.send(task1_thread->get_pid()), 1);
+    EXPECT_EQ(msg2.send(task1_thread->get_pid()), 1);
+    EXPECT_EQ(msg3.send(task1_thread->get_pid()), 1);
+
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 3);
+
+    instance->get<ThreadScheduler>().wakeup_thread(task1_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] receive them back, only the used length is copied
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg rmsg = Msg(*instance);
+
+    memset(&rmsg.content, 0xee, sizeof(rmsg.content));
+
+    EXPECT_EQ(rmsg.receive(), 1);
+    EXPECT_EQ(rmsg.type, 0x1);
+    EXPECT_EQ(rmsg.get_payload_size(), sizeof(struct sample));
+
+    struct sample r1;
+
+    rmsg.get_payload(r1);
+
+    EXPECT_EQ(r1.timestamp, 0x12345678);
+    EXPECT_EQ(r1.x, -1);
+    EXPECT_EQ(r1.y, 2);
+    EXPECT_EQ(r1.z, -3);
+
+    memset(&rmsg.content, 0xee, sizeof(rmsg.content));
+
+    EXPECT_EQ(rmsg.receive(), 1);
+    EXPECT_EQ(rmsg.type, 0x2);
+    EXPECT_EQ(rmsg.get_payload_size(), sizeof(raw));
+    EXPECT_EQ(memcmp(rmsg.content.data, raw, sizeof(raw)), 0);
+    EXPECT_EQ(rmsg.content.data[VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE - 1], 0xee);
+
+    memset(&rmsg.content, 0xee, sizeof(rmsg.content));
+
+    EXPECT_EQ(rmsg.receive(), 1);
+    EXPECT_EQ(rmsg.type, 0x3);
+    EXPECT_EQ(rmsg.get_payload_size(), 0);
+    EXPECT_EQ(rmsg.content.value, 0xdeadbeef);
+    EXPECT_EQ(rmsg.content.data[VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE - 1], 0xee);
+
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 0);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] typed payload copied straight into a receive blocked thread
+     * -------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(rmsg.receive(), 1);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    s1.timestamp = 0xcafe;
+
+    msg1.set_payload(s1);
+
+    EXPECT_EQ(msg1.send(task1_thread->get_pid()), 1);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+    EXPECT_EQ(rmsg.sender_pid, main_thread->get_pid());
+    EXPECT_EQ(rmsg.get_payload_size(), sizeof(struct sample));
+
+    rmsg.get_payload(r1);
+
+    EXPECT_EQ(r1.timestamp, 0xcafe);
+}
+
+TEST_F(TestMsg, priority_queue_test)
+{
+    EXPECT_TRUE(instance->is_initialized());
+
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+
+    Thread *idle_thread = Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(idle_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    /* 4 bands of 2 msgs, band = priority * 4 / 16 */
+
+    Msg task1_msg_array[8];
+    msg_prio_queue_t task1_prio_queue;
+
+    task1_thread->init_msg_queue(task1_msg_array, ARRAY_LENGTH(task1_msg_array), &task1_prio_queue);
+
+    EXPECT_EQ(task1_thread->has_msg_queue(), 1);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 0);
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] bulk msgs take the sender priority, a full band rejects more
+     * msgs while the other bands still accept them
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg msg = Msg(*instance);
+
+    EXPECT_EQ(msg.get_priority(), MSG_PRIORITY_AUTO);
+
+    msg.type = 0x71;
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+
+    msg.type = 0x72;
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+
+    msg.type = 0x73;
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 0);
+
+    msg.type = 0xf0;
+    msg.set_priority(15);
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+
+    msg.type = 0x01;
+    msg.set_priority(0);
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+
+    msg.type = 0x02;
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 5);
+
+    /* msg from ISR is treated as most urgent */
+
+    test_helper_set_cpu_in_isr();
+
+    Msg isr_msg = Msg(*instance);
+    isr_msg.type = 0x03;
+
+    EXPECT_EQ(isr_msg.send(task1_thread->get_pid()), 0); /* control band full */
+
+    test_helper_reset_cpu_in_isr();
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] receive returns the most urgent band first, FIFO within a band
+     * -------------------------------------------------------------------------
+     **/
+
+    instance->get<ThreadScheduler>().wakeup_thread(task1_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    const uint16_t expected[] = {0x01, 0x02, 0x71, 0x72, 0xf0};
+
+    Msg rmsg = Msg(*instance);
+
+    for (unsigned int i = 0; i < ARRAY_LENGTH(expected); i++)
+    {
+        EXPECT_EQ(rmsg.try_receive(), 1);
+        EXPECT_EQ(rmsg.type, expected[i]);
+        EXPECT_EQ(rmsg.sender_pid, main_thread->get_pid());
+    }
+
+    EXPECT_EQ(rmsg.try_receive(), -1);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 0);
+}
+
+TEST_F(TestMsg, batch_send_and_receive_test)
+{
+    EXPECT_TRUE(instance->is_initialized());
+
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+    char task2_stack[128];
+
+    Thread *idle_thread = Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    Thread *task2_thread = Thread::init(*instance, task2_stack, sizeof(task2_stack), 6,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task2");
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    Msg task1_msg_array[4];
+
+    task1_thread->init_msg_queue(task1_msg_array, ARRAY_LENGTH(task1_msg_array));
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task2_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] send batch fills the target queue in one go, the next senders
+     * block on the full queue
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg batch[4];
+
+    for (int i = 0; i < 4; i++)
+    {
+        batch[i].init(*instance);
+        batch[i].type = 0x10 + i;
+    }
+
+    EXPECT_EQ(Msg::send_batch(batch, 4, task1_thread->get_pid()), 4);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 4);
+
+    Msg task2_msg = Msg(*instance);
+    task2_msg.type = 0x20;
+
+    task2_msg.send(task1_thread->get_pid());
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_SEND_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    Msg main_msg = Msg(*instance);
+    main_msg.type = 0x30;
+
+    main_msg.send(task1_thread->get_pid());
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_SEND_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(idle_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    instance->get<ThreadScheduler>().wakeup_thread(task1_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] receive batch drains the queue and moves both waiting senders
+     * into the freed slots
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg out[8];
+
+    out[0].init(*instance);
+
+    EXPECT_EQ(Msg::receive_batch(out, 3), 3);
+
+    EXPECT_EQ(out[0].type, 0x10);
+    EXPECT_EQ(out[1].type, 0x11);
+    EXPECT_EQ(out[2].type, 0x12);
+    EXPECT_EQ(out[2].sender_pid, task2_thread->get_pid());
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 3);
+
+    EXPECT_EQ(Msg::receive_batch(out, 8), 3);
+
+    EXPECT_EQ(out[0].type, 0x13);
+    EXPECT_EQ(out[1].type, 0x20);
+    EXPECT_EQ(out[2].type, 0x30);
+    EXPECT_EQ(out[2].sender_pid, main_thread->get_pid());
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] first msg of a batch goes straight to a receive blocked thread
+     * -------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(Msg::receive_batch(out, 8), 1);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task2_thread);
+
+    EXPECT_EQ(Msg::send_batch(batch, 3, task1_thread->get_pid()), 3);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(out[0].type, 0x10);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 2);
+
+    EXPECT_EQ(Msg::send_batch(batch, 1, KERNEL_PID_UNDEF), -1);
+}
+
+TEST_F(TestMsg, batch_benchmark_test)
+{
+    const int batch_size = 64;
+    const int iterations = 2000;
+
+    char idle_stack[128];
+    char task1_stack[128];
+    char task2_stack[128];
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    Thread *task2_thread = Thread::init(*instance, task2_stack, sizeof(task2_stack), 6,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task2");
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    Msg task1_msg_array[batch_size];
+    Msg task2_msg_array[batch_size];
+
+    task1_thread->init_msg_queue(task1_msg_array, batch_size);
+    task2_thread->init_msg_queue(task2_msg_array, batch_size);
+
+    instance->get<ThreadScheduler>().set_thread_status(task2_thread, THREAD_STATUS_SLEEPING);
+
+    Msg msgs[batch_size];
+
+    for (int i = 0; i < batch_size; i++)
+    {
+        msgs[i].init(*instance);
+        msgs[i].type = i;
+    }
+
+    std::chrono::nanoseconds single_send(0), batch_send(0), single_recv(0), batch_recv(0);
+
+    for (int n = 0; n < iterations; n++)
+    {
+        /* send task1 -> sleeping task2 */
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < batch_size; i++)
+        {
+            msgs[i].try_send(task2_thread->get_pid());
+        }
+
+        single_send += std::chrono::steady_clock::now() - start;
+
+        while (task2_thread->dequeue_msg(&msgs[0]))
+        {
+        }
+
+        start = std::chrono::steady_clock::now();
+
+        Msg::send_batch(msgs, batch_size, task2_thread->get_pid());
+
+        batch_send += std::chrono::steady_clock::now() - start;
+
+        while (task2_thread->dequeue_msg(&msgs[0]))
+        {
+        }
+
+        /* receive from the own queue of task1 */
+
+        for (int i = 0; i < batch_size; i++)
+        {
+            task1_thread->queued_msg(&msgs[i]);
+        }
+
+        start = std::chrono::steady_clock::now();
+
+        for (int i = 0; i < batch_size; i++)
+        {
+            msgs[i].try_receive();
+        }
+
+        single_recv += std::chrono::steady_clock::now() - start;
+
+        for (int i = 0; i < batch_size; i++)
+        {
+            task1_thread->queued_msg(&msgs[i]);
+        }
+
+        start = std::chrono::steady_clock::now();
+
+        EXPECT_EQ(Msg::receive_batch(msgs, batch_size), batch_size);
+
+        batch_recv += std::chrono::steady_clock::now() - start;
+    }
+
+    const double total = static_cast<double>(batch_size) * iterations;
+
+    printf("[ BENCHMARK] msg send single : %.1f Mmsg/s\n", total / single_send.count() * 1000.0);
+    printf("[ BENCHMARK] msg send batch  : %.1f Mmsg/s\n", total / batch_send.count() * 1000.0);
+    printf("[ BENCHMARK] msg recv single : %.1f Mmsg/s\n", total / single_recv.count() * 1000.0);
+    printf("[ BENCHMARK] msg recv batch  : %.1f Mmsg/s\n", total / batch_recv.count() * 1000.0);
+}
+
+TEST_F(TestMsg, overflow_policy_test)
+{
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    instance->get<ThreadScheduler>().run();
+
+    Msg task1_msg_array[2];
+
+    task1_thread->init_msg_queue(task1_msg_array, ARRAY_LENGTH(task1_msg_array));
+
+    EXPECT_EQ(task1_thread->get_msg_queue_policy(), MSG_QUEUE_POLICY_BLOCK);
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    msg_queue_stats_t stats;
+
+    task1_thread->set_msg_queue_stats(&stats);
+
+    EXPECT_EQ(task1_thread->get_msg_queue_stats(), &stats);
+    EXPECT_EQ(stats.rejected, 0);
+
+    Msg msg = Msg(*instance);
+
+    msg.type = 1;
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+
+    msg.type = 2;
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] block policy: try send and send from ISR are rejected
+     * -------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 0);
+
+    test_helper_set_cpu_in_isr();
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 0);
+    test_helper_reset_cpu_in_isr();
+
+    EXPECT_EQ(stats.rejected, 2);
+    EXPECT_EQ(stats.blocked, 0);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] reject policy: blocking send fails instead of blocking
+     * -------------------------------------------------------------------------
+     **/
+
+    task1_thread->set_msg_queue_policy(MSG_QUEUE_POLICY_REJECT);
+
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 0);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(stats.rejected, 3);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] drop oldest policy: queue keeps the newest msgs
+     * -------------------------------------------------------------------------
+     **/
+
+    task1_thread->set_msg_queue_policy(MSG_QUEUE_POLICY_DROP_OLDEST);
+
+    msg.type = 3;
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 1);
+    EXPECT_EQ(stats.dropped, 1);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 2);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] overwrite policy: newest msg of the same type is replaced,
+     * a type that is not queued is rejected
+     * -------------------------------------------------------------------------
+     **/
+
+    task1_thread->set_msg_queue_policy(MSG_QUEUE_POLICY_OVERWRITE);
+
+    msg.type = 2;
+    msg.content.value = 99;
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 1);
+    EXPECT_EQ(stats.overwritten, 1);
+
+    msg.type = 7;
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 0);
+    EXPECT_EQ(stats.rejected, 4);
+
+    instance->get<ThreadScheduler>().wakeup_thread(task1_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    Msg rmsg = Msg(*instance);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 2);
+    EXPECT_EQ(rmsg.content.value, 99);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 3);
+
+    EXPECT_EQ(rmsg.try_receive(), -1);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] queued request of a reply blocked client is neither dropped
+     * nor overwritten
+     * -------------------------------------------------------------------------
+     **/
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    Msg reply = Msg(*instance);
+
+    msg.type = 5;
+    EXPECT_EQ(msg.send_receive(&reply, task1_thread->get_pid()), 1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_REPLY_BLOCKED);
+
+    Msg isr_msg = Msg(*instance);
+
+    test_helper_set_cpu_in_isr();
+
+    isr_msg.type = 6;
+    EXPECT_EQ(isr_msg.send(task1_thread->get_pid()), 1);
+
+    task1_thread->set_msg_queue_policy(MSG_QUEUE_POLICY_DROP_OLDEST);
+
+    isr_msg.type = 7;
+    EXPECT_EQ(isr_msg.send(task1_thread->get_pid()), 0);
+
+    task1_thread->set_msg_queue_policy(MSG_QUEUE_POLICY_OVERWRITE);
+
+    isr_msg.type = 5;
+    EXPECT_EQ(isr_msg.send(task1_thread->get_pid()), 0);
+
+    test_helper_reset_cpu_in_isr();
+
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 2);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_REPLY_BLOCKED);
+
+    instance->get<ThreadScheduler>().wakeup_thread(task1_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 5);
+    EXPECT_EQ(rmsg.sender_pid, main_thread->get_pid());
+    EXPECT_EQ(rmsg.reply(&rmsg), 1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 6);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] block policy: blocking send on a full queue is counted
+     * -------------------------------------------------------------------------
+     **/
+
+    task1_thread->set_msg_queue_policy(MSG_QUEUE_POLICY_BLOCK);
+    task1_thread->reset_msg_queue_stats();
+
+    EXPECT_EQ(stats.rejected, 0);
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 1);
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 1);
+
+    msg.send(task1_thread->get_pid());
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_SEND_BLOCKED);
+    EXPECT_EQ(stats.blocked, 1);
+}
+
+TEST_F(TestMsg, queue_stats_test)
+{
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task1_thread->get_msg_queue_size(), 0);
+
+    Msg task1_msg_array[4];
+
+    task1_thread->init_msg_queue(task1_msg_array, ARRAY_LENGTH(task1_msg_array));
+
+    EXPECT_EQ(task1_thread->get_msg_queue_size(), 4);
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    msg_queue_stats_t stats;
+
+    task1_thread->set_msg_queue_stats(&stats);
+
+    EXPECT_EQ(stats.enqueued, 0);
+    EXPECT_EQ(stats.dequeued, 0);
+    EXPECT_EQ(stats.high_water, 0);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] enqueued msgs raise the high water mark
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg msg = Msg(*instance);
+
+    for (int i = 0; i < 3; i++)
+    {
+        msg.type = i;
+        EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+    }
+
+    EXPECT_EQ(stats.enqueued, 3);
+    EXPECT_EQ(stats.high_water, 3);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] dequeued msgs keep the high water mark
+     * -------------------------------------------------------------------------
+     **/
+
+    instance->get<ThreadScheduler>().wakeup_thread(task1_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    Msg rmsg = Msg(*instance);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.try_receive(), 1);
+
+    EXPECT_EQ(stats.dequeued, 2);
+    EXPECT_EQ(stats.high_water, 3);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 1);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] filling the queue and blocking on it
+     * -------------------------------------------------------------------------
+     **/
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+    }
+
+    EXPECT_EQ(stats.enqueued, 6);
+    EXPECT_EQ(stats.high_water, 4);
+
+    msg.send(task1_thread->get_pid());
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_SEND_BLOCKED);
+    EXPECT_EQ(stats.blocked, 1);
+    EXPECT_EQ(stats.rejected, 0);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] reset clears all counters
+     * -------------------------------------------------------------------------
+     **/
+
+    task1_thread->reset_msg_queue_stats();
+
+    EXPECT_EQ(stats.enqueued, 0);
+    EXPECT_EQ(stats.dequeued, 0);
+    EXPECT_EQ(stats.blocked, 0);
+    EXPECT_EQ(stats.blocked_time, 0);
+    EXPECT_EQ(stats.high_water, 0);
+}
+
+TEST_F(TestMsg, timestamp_test)
+{
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+
+    test_helper_ztimer_reset();
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    instance->get<ThreadScheduler>().run();
+
+    Msg task1_msg_array[4];
+
+    task1_thread->init_msg_queue(task1_msg_array, ARRAY_LENGTH(task1_msg_array));
+
+    msg_queue_stats_t stats;
+
+    task1_thread->set_msg_queue_stats(&stats);
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] send stamps timestamp and origin
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg msg = Msg(*instance);
+
+    EXPECT_EQ(msg.get_timestamp(), 0);
+    EXPECT_EQ(msg.get_origin(), 0);
+
+    test_helper_ztimer_advance(100);
+
+    msg.type = 1;
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 1);
+    EXPECT_EQ(msg.get_timestamp(), 100);
+    EXPECT_EQ(msg.get_origin(), 100);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] a set origin is carried by send
+     * -------------------------------------------------------------------------
+     **/
+
+    test_helper_ztimer_advance(40);
+
+    msg.type = 2;
+    msg.set_origin(10);
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 1);
+    EXPECT_EQ(msg.get_timestamp(), 140);
+    EXPECT_EQ(msg.get_origin(), 10);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] receive records the queue wait in the latency histogram
+     * -------------------------------------------------------------------------
+     **/
+
+    instance->get<ThreadScheduler>().wakeup_thread(task1_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    test_helper_ztimer_advance(60);
+
+    Msg rmsg = Msg(*instance);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 1);
+    EXPECT_EQ(rmsg.get_latency(), 100);
+    EXPECT_EQ(rmsg.get_end_to_end_latency(), 100);
+    EXPECT_EQ(stats.latency_hist[3], 1); /* 64 .. 127 usec */
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 2);
+    EXPECT_EQ(rmsg.get_latency(), 60);
+    EXPECT_EQ(rmsg.get_end_to_end_latency(), 190);
+    EXPECT_EQ(stats.latency_hist[2], 1); /* 32 .. 63 usec */
+
+    EXPECT_EQ(stats.latency_max, 100);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] forwarding a received msg keeps its origin
+     * -------------------------------------------------------------------------
+     **/
+
+    rmsg.keep_origin();
+    EXPECT_EQ(rmsg.send_to_self_queue(), 1);
+    EXPECT_EQ(rmsg.get_timestamp(), 200);
+    EXPECT_EQ(rmsg.get_origin(), 10);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.get_origin(), 10);
+    EXPECT_EQ(rmsg.get_latency(), 0);
+    EXPECT_EQ(stats.latency_hist[0], 1);
+
+    /* the received copy does not keep the origin anymore */
+
+    test_helper_ztimer_advance(5);
+
+    EXPECT_EQ(rmsg.send_to_self_queue(), 1);
+    EXPECT_EQ(rmsg.get_origin(), 205);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+}
+
+TEST_F(TestMsg, async_request_test)
+{
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+    char task2_stack[128];
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    Thread *task2_thread = Thread::init(*instance, task2_stack, sizeof(task2_stack), 4,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task2");
+
+    Msg task1_msg_array[2];
+    Msg task2_msg_array[2];
+
+    task1_thread->init_msg_queue(task1_msg_array, ARRAY_LENGTH(task1_msg_array));
+    task2_thread->init_msg_queue(task2_msg_array, ARRAY_LENGTH(task2_msg_array));
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().set_thread_status(task2_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] fan out requests without waiting for the replies
+     * -------------------------------------------------------------------------
+     **/
+
+    MsgFuture futures[2];
+
+    futures[0].init(*instance);
+    futures[1].init(*instance);
+
+    EXPECT_FALSE(futures[0].is_pending());
+    EXPECT_EQ(Msg::wait_any(futures, ARRAY_LENGTH(futures)), -1);
+
+    Msg msg = Msg(*instance);
+
+    msg.type = 1;
+    EXPECT_EQ(msg.send_async(task1_thread->get_pid(), &futures[0]), 1);
+
+    msg.type = 2;
+    EXPECT_EQ(msg.send_async(task2_thread->get_pid(), &futures[1]), 1);
+
+    EXPECT_EQ(msg.correlation_id, 0);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    EXPECT_TRUE(futures[0].is_pending());
+    EXPECT_TRUE(futures[1].is_pending());
+    EXPECT_NE(futures[0].get_correlation_id(), 0);
+    EXPECT_NE(futures[0].get_correlation_id(), futures[1].get_correlation_id());
+
+    EXPECT_EQ(Msg::poll_any(futures, ARRAY_LENGTH(futures)), -1);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] reply completes the future with the matching correlation id
+     * -------------------------------------------------------------------------
+     **/
+
+    instance->get<ThreadScheduler>().wakeup_thread(task2_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task2_thread);
+
+    Msg request = Msg(*instance);
+    Msg response = Msg(*instance);
+
+    EXPECT_EQ(request.try_receive(), 1);
+    EXPECT_EQ(request.type, 2);
+    EXPECT_EQ(request.correlation_id, futures[1].get_correlation_id());
+
+    response.content.value = 22;
+
+    EXPECT_EQ(request.reply(&response), 1);
+
+    EXPECT_TRUE(futures[1].is_done());
+    EXPECT_EQ(futures[1].get_reply().content.value, 22);
+    EXPECT_EQ(futures[1].get_reply().correlation_id, futures[1].get_correlation_id());
+    EXPECT_TRUE(futures[0].is_pending());
+    EXPECT_NE(main_thread->flags & THREAD_FLAG_MSG_REPLY, 0);
+
+    /* a second reply to the same request finds no pending future */
+
+    EXPECT_EQ(request.reply(&response), -1);
+
+    instance->get<ThreadScheduler>().set_thread_status(task2_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    /* Note: the reply flag is a kernel flag, user flags are left alone */
+
+    EXPECT_EQ(THREAD_FLAG_MSG_REPLY, 0x8000);
+
+    instance->get<ThreadScheduler>().thread_flags_set(main_thread, 0x2);
+
+    EXPECT_EQ(Msg::wait_any(futures, ARRAY_LENGTH(futures)), 1);
+    EXPECT_NE(main_thread->flags & 0x2, 0);
+    EXPECT_EQ(main_thread->flags & THREAD_FLAG_MSG_REPLY, 0);
+
+    instance->get<ThreadScheduler>().thread_flags_clear(0x2);
+
+    /* a taken future is returned only once and keeps its reply */
+
+    EXPECT_FALSE(futures[1].is_done());
+    EXPECT_FALSE(futures[1].is_pending());
+    EXPECT_EQ(futures[1].get_reply().content.value, 22);
+    EXPECT_EQ(Msg::poll_any(futures, ARRAY_LENGTH(futures)), -1);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] reply to a cancelled request is dropped
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg::cancel(&futures[0]);
+
+    EXPECT_FALSE(futures[0].is_pending());
+
+    instance->get<ThreadScheduler>().wakeup_thread(task1_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    EXPECT_EQ(request.try_receive(), 1);
+    EXPECT_EQ(request.type, 1);
+    EXPECT_EQ(request.reply(&response), -1);
+    EXPECT_FALSE(futures[0].is_done());
+
+    instance->get<ThreadScheduler>().set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    /* nothing is pending anymore */
+
+    Msg::wait_all(futures, ARRAY_LENGTH(futures));
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] failed send does not leave a pending future behind
+     * -------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(msg.send_async(KERNEL_PID_LAST, &futures[0]), -1);
+    EXPECT_FALSE(futures[0].is_pending());
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_msg_futures(main_thread->get_pid())->next, nullptr);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] cancel drops a done future
+     * -------------------------------------------------------------------------
+     **/
+
+    msg.type = 3;
+    EXPECT_EQ(msg.send_async(task2_thread->get_pid(), &futures[1]), 1);
+
+    instance->get<ThreadScheduler>().wakeup_thread(task2_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task2_thread);
+
+    EXPECT_EQ(request.try_receive(), 1);
+    EXPECT_EQ(request.type, 3);
+    EXPECT_EQ(request.reply(&response), 1);
+
+    instance->get<ThreadScheduler>().set_thread_status(task2_thread, THREAD_STATUS_SLEEPING);
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_TRUE(futures[1].is_done());
+
+    Msg::cancel(&futures[1]);
+
+    EXPECT_FALSE(futures[1].is_done());
+    EXPECT_EQ(Msg::poll_any(futures, ARRAY_LENGTH(futures)), -1);
+}
+
+TEST_F(TestMsg, stale_reply_test)
+{
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+    char task2_stack[128];
+
+    test_helper_ztimer_reset();
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    Thread *task2_thread = Thread::init(*instance, task2_stack, sizeof(task2_stack), 6,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task2");
+
+    ThreadScheduler &scheduler = instance->get<ThreadScheduler>();
+
+    scheduler.run();
+
+    /* task1 and task2 are both servers waiting for a request */
+
+    Msg request1 = Msg(*instance);
+    Msg request2 = Msg(*instance);
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task1_thread);
+
+    request1.receive();
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task2_thread);
+
+    request2.receive();
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), main_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] request received by task1 times out before the reply
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg msg = Msg(*instance);
+    Msg reply = Msg(*instance);
+    MsgTimeout msg_timeout;
+
+    msg.type = 1;
+
+    EXPECT_EQ(msg.send_receive_timeout(&reply, task1_thread->get_pid(), 100, &msg_timeout), 1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_REPLY_BLOCKED);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(request1.type, 1);
+
+    test_helper_ztimer_advance(100);
+
+    EXPECT_EQ(msg_timeout.timed_out, 1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] late reply of task1 does not end the next call to task2
+     * -------------------------------------------------------------------------
+     **/
+
+    scheduler.set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), main_thread);
+
+    msg.type = 2;
+
+    EXPECT_EQ(msg.send_receive(&reply, task2_thread->get_pid()), 1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_REPLY_BLOCKED);
+    EXPECT_EQ(request2.type, 2);
+
+    scheduler.wakeup_thread(task1_thread->get_pid());
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task1_thread);
+
+    Msg response = Msg(*instance);
+
+    response.content.value = 1;
+
+    EXPECT_EQ(request1.reply(&response), -1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_REPLY_BLOCKED);
+    EXPECT_NE(reply.content.value, 1);
+
+    scheduler.set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task2_thread);
+
+    response.content.value = 2;
+
+    EXPECT_EQ(request2.reply(&response), 1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(reply.content.value, 2);
+}
+
+TEST_F(TestMsg, priority_inheritance_test)
+{
+    char idle_stack[128];
+    char client_stack[128];
+    char medium_stack[128];
+    char server_stack[128];
+    char server2_stack[128];
+
+    test_helper_ztimer_reset();
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *client_thread = Thread::init(*instance, client_stack, sizeof(client_stack), 3,
+                                         THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                         NULL, NULL, "client");
+
+    Thread *medium_thread = Thread::init(*instance, medium_stack, sizeof(medium_stack), 6,
+                                         THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                         NULL, NULL, "medium");
+
+    Thread *server_thread = Thread::init(*instance, server_stack, sizeof(server_stack), 10,
+                                         THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                         NULL, NULL, "server");
+
+    Thread *server2_thread = Thread::init(*instance, server2_stack, sizeof(server2_stack), 11,
+                                          THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                          NULL, NULL, "server2");
+
+    ThreadScheduler &scheduler = instance->get<ThreadScheduler>();
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), client_thread);
+    EXPECT_EQ(server_thread->get_base_priority(), 10);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] server that received a request runs at the client priority
+     * -------------------------------------------------------------------------
+     **/
+
+    scheduler.set_thread_status(client_thread, THREAD_STATUS_SLEEPING);
+    scheduler.set_thread_status(medium_thread, THREAD_STATUS_SLEEPING);
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), server_thread);
+
+    Msg request = Msg(*instance);
+
+    request.receive();
+
+    EXPECT_EQ(server_thread->get_status(), THREAD_STATUS_RECEIVE_BLOCKED);
+
+    scheduler.wakeup_thread(client_thread->get_pid());
+    scheduler.wakeup_thread(medium_thread->get_pid());
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), client_thread);
+
+    Msg msg = Msg(*instance);
+    Msg reply = Msg(*instance);
+
+    EXPECT_EQ(msg.send_receive(&reply, server_thread->get_pid()), 1);
+    EXPECT_EQ(client_thread->get_status(), THREAD_STATUS_REPLY_BLOCKED);
+    EXPECT_EQ(server_thread->get_priority(), 3);
+
+    scheduler.run();
+
+    /* without inheritance the medium thread would run here */
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), server_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] reply restores the server priority
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg response = Msg(*instance);
+
+    EXPECT_EQ(request.reply(&response), 1);
+    EXPECT_EQ(server_thread->get_priority(), 10);
+    EXPECT_EQ(client_thread->get_status(), THREAD_STATUS_PENDING);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), client_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] reply blocked client waiting for a busy server boosts it
+     * -------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(server_thread->get_status(), THREAD_STATUS_PENDING);
+
+    EXPECT_EQ(msg.send_receive(&reply, server_thread->get_pid()), 1);
+    EXPECT_NE(server_thread->msg_waiters.next, nullptr);
+    EXPECT_EQ(server_thread->get_priority(), 3);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), server_thread);
+
+    EXPECT_EQ(request.receive(), 1);
+    EXPECT_EQ(server_thread->msg_waiters.next, nullptr);
+    EXPECT_EQ(server_thread->get_priority(), 3);
+
+    EXPECT_EQ(request.reply(&response), 1);
+    EXPECT_EQ(server_thread->get_priority(), 10);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), client_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] timed out request drops the inherited priority
+     * -------------------------------------------------------------------------
+     **/
+
+    MsgTimeout msg_timeout;
+
+    EXPECT_EQ(msg.send_receive_timeout(&reply, server_thread->get_pid(), 100, &msg_timeout), 1);
+    EXPECT_EQ(server_thread->get_priority(), 3);
+
+    test_helper_ztimer_advance(100);
+
+    EXPECT_EQ(msg_timeout.timed_out, 1);
+    EXPECT_EQ(server_thread->get_priority(), 10);
+    EXPECT_EQ(client_thread->get_status(), THREAD_STATUS_PENDING);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), client_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] late reply to a timed out request keeps the boost of the
+     * server the client called next
+     * -------------------------------------------------------------------------
+     **/
+
+    scheduler.set_thread_status(client_thread, THREAD_STATUS_SLEEPING);
+    scheduler.set_thread_status(medium_thread, THREAD_STATUS_SLEEPING);
+    scheduler.set_thread_status(server_thread, THREAD_STATUS_SLEEPING);
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), server2_thread);
+
+    Msg request2 = Msg(*instance);
+
+    request2.receive();
+
+    scheduler.wakeup_thread(client_thread->get_pid());
+    scheduler.wakeup_thread(medium_thread->get_pid());
+    scheduler.wakeup_thread(server_thread->get_pid());
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), client_thread);
+
+    EXPECT_EQ(msg.send_receive_timeout(&reply, server_thread->get_pid(), 100, &msg_timeout), 1);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), server_thread);
+    EXPECT_EQ(request.receive(), 1);
+    EXPECT_EQ(server_thread->get_priority(), 3);
+
+    test_helper_ztimer_advance(100);
+
+    EXPECT_EQ(msg_timeout.timed_out, 1);
+    EXPECT_EQ(server_thread->get_priority(), 10);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), client_thread);
+
+    EXPECT_EQ(msg.send_receive(&reply, server2_thread->get_pid()), 1);
+    EXPECT_EQ(server2_thread->get_priority(), 3);
+
+    scheduler.set_thread_status(server2_thread, THREAD_STATUS_SLEEPING);
+    scheduler.set_thread_status(medium_thread, THREAD_STATUS_SLEEPING);
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), server_thread);
+
+    EXPECT_EQ(request.reply(&response), -1);
+    EXPECT_EQ(server2_thread->get_priority(), 3);
+    EXPECT_EQ(client_thread->get_status(), THREAD_STATUS_REPLY_BLOCKED);
+
+    scheduler.wakeup_thread(server2_thread->get_pid());
+    scheduler.wakeup_thread(medium_thread->get_pid());
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), server2_thread);
+
+    EXPECT_EQ(request2.reply(&response), 1);
+    EXPECT_EQ(server2_thread->get_priority(), 11);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), client_thread);
+}
+
+static int match_type_above(const msg_t *msg, void *arg)
+{
+    return msg->type > *static_cast<uint16_t *>(arg);
+}
+
+TEST_F(TestMsg, filtered_receive_test)
+{
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+
+    test_helper_ztimer_reset();
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    ThreadScheduler &scheduler = instance->get<ThreadScheduler>();
+
+    scheduler.run();
+
+    Msg task1_msg_array[4];
+
+    task1_thread->init_msg_queue(task1_msg_array, ARRAY_LENGTH(task1_msg_array));
+
+    scheduler.set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), main_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] matching msg is taken out of order, the rest keeps its order
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg msg = Msg(*instance);
+    Msg rmsg = Msg(*instance);
+
+    for (uint16_t type = 1; type <= 3; type++)
+    {
+        msg.type = type;
+        EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+    }
+
+    scheduler.wakeup_thread(task1_thread->get_pid());
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task1_thread);
+
+    MsgFilter filter_type2 = MsgFilter(2);
+
+    EXPECT_EQ(rmsg.try_receive_filtered(&filter_type2), 1);
+    EXPECT_EQ(rmsg.type, 2);
+    EXPECT_EQ(rmsg.sender_pid, main_thread->get_pid());
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 2);
+
+    EXPECT_EQ(rmsg.try_receive_filtered(&filter_type2), -1);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 1);
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 3);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] type mask and predicate filters
+     * -------------------------------------------------------------------------
+     **/
+
+    scheduler.set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    scheduler.run();
+
+    uint16_t types[] = {0x21, 0x13, 0x40, 0x14};
+
+    for (unsigned i = 0; i < ARRAY_LENGTH(types); i++)
+    {
+        msg.type = types[i];
+        EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+    }
+
+    scheduler.wakeup_thread(task1_thread->get_pid());
+    scheduler.run();
+
+    MsgFilter filter_group1 = MsgFilter(0x10, 0xf0);
+
+    EXPECT_EQ(rmsg.try_receive_filtered(&filter_group1), 1);
+    EXPECT_EQ(rmsg.type, 0x13);
+
+    uint16_t above = 0x30;
+    MsgFilter filter_above = MsgFilter(match_type_above, &above);
+
+    EXPECT_EQ(rmsg.try_receive_filtered(&filter_above), 1);
+    EXPECT_EQ(rmsg.type, 0x40);
+    EXPECT_EQ(rmsg.try_receive_filtered(&filter_above), -1);
+
+    EXPECT_EQ(rmsg.try_receive_filtered(&filter_group1), 1);
+    EXPECT_EQ(rmsg.type, 0x14);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 0x21);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 0);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] blocked receiver only wakes up for a matching msg
+     * -------------------------------------------------------------------------
+     **/
+
+    MsgFilter filter_type5 = MsgFilter(5);
+    MsgFilterWait wait;
+
+    EXPECT_EQ(rmsg.receive_filtered_timeout(&filter_type5, 0, &wait), 0);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_FILTERED_BLOCKED);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), main_thread);
+
+    msg.type = 6;
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_FILTERED_BLOCKED);
+
+    msg.type = 5;
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task1_thread);
+
+    EXPECT_EQ(rmsg.receive_filtered_timeout(&filter_type5, 0, &wait), 1);
+    EXPECT_EQ(rmsg.type, 5);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 6);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] filtered receive times out
+     * -------------------------------------------------------------------------
+     **/
+
+    MsgFilter filter_type9 = MsgFilter(9);
+
+    EXPECT_EQ(rmsg.receive_filtered_timeout(&filter_type9, 100, &wait), 0);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_FILTERED_BLOCKED);
+
+    scheduler.run();
+
+    msg.type = 1;
+    EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+
+    test_helper_ztimer_advance(100);
+
+    EXPECT_EQ(wait.timed_out, 1);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task1_thread);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 1);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] waiting sender moves into the freed slot or gets matched
+     * -------------------------------------------------------------------------
+     **/
+
+    scheduler.set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    scheduler.run();
+
+    for (uint16_t type = 1; type <= 4; type++)
+    {
+        msg.type = type;
+        EXPECT_EQ(msg.try_send(task1_thread->get_pid()), 1);
+    }
+
+    msg.type = 8;
+    msg.send(task1_thread->get_pid());
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_SEND_BLOCKED);
+
+    scheduler.wakeup_thread(task1_thread->get_pid());
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task1_thread);
+
+    MsgFilter filter_type3 = MsgFilter(3);
+
+    EXPECT_EQ(rmsg.try_receive_filtered(&filter_type3), 1);
+    EXPECT_EQ(rmsg.type, 3);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 4);
+
+    scheduler.set_thread_status(task1_thread, THREAD_STATUS_SLEEPING);
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), main_thread);
+
+    msg.type = 9;
+    msg.send(task1_thread->get_pid());
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_SEND_BLOCKED);
+
+    scheduler.wakeup_thread(task1_thread->get_pid());
+    scheduler.run();
+
+    EXPECT_EQ(rmsg.try_receive_filtered(&filter_type9), 1);
+    EXPECT_EQ(rmsg.type, 9);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 4);
+
+    uint16_t expected[] = {1, 2, 4, 8};
+
+    for (unsigned i = 0; i < ARRAY_LENGTH(expected); i++)
+    {
+        EXPECT_EQ(rmsg.try_receive(), 1);
+        EXPECT_EQ(rmsg.type, expected[i]);
+    }
+}
+
+TEST_F(TestMsg, isr_queue_test)
+{
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    ThreadScheduler &scheduler = instance->get<ThreadScheduler>();
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task1_thread);
+
+    Msg isr_msg_array[4];
+    MsgIsrQueue isr_queue;
+
+    isr_queue.init(isr_msg_array, ARRAY_LENGTH(isr_msg_array));
+
+    scheduler.set_msg_isr_queue(task1_thread->get_pid(), &isr_queue);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] isr send to a receive blocked thread is delivered right away
+     * with multiple instances (cpu_end_of_isr() is covered by the single
+     * instance msg_isr_queue suite)
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg rmsg = Msg(*instance);
+
+    rmsg.receive();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_BLOCKED);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), main_thread);
+
+    test_helper_set_cpu_in_isr();
+
+    Msg msg = Msg(*instance);
+
+    msg.type = 0x11;
+    msg.content.value = 0x12345678;
+
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 1);
+
+    EXPECT_TRUE(scheduler.is_context_switch_requested());
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(isr_queue.get_numof_msgs(), 0);
+
+    test_helper_reset_cpu_in_isr();
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task1_thread);
+
+    EXPECT_EQ(rmsg.type, 0x11);
+    EXPECT_EQ(rmsg.content.value, 0x12345678);
+    EXPECT_EQ(rmsg.sender_pid, KERNEL_PID_ISR);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] isr sends to a running thread stay queued in order
+     * -------------------------------------------------------------------------
+     **/
+
+    test_helper_set_cpu_in_isr();
+
+    for (uint16_t type = 1; type <= 4; type++)
+    {
+        msg.type = type;
+        EXPECT_EQ(msg.send(task1_thread->get_pid()), 1);
+    }
+
+    msg.type = 5;
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 0);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(isr_queue.get_numof_msgs(), 4);
+
+    test_helper_reset_cpu_in_isr();
+
+    for (uint16_t type = 1; type <= 4; type++)
+    {
+        EXPECT_EQ(rmsg.try_receive(), 1);
+        EXPECT_EQ(rmsg.type, type);
+    }
+
+    EXPECT_EQ(rmsg.try_receive(), -1);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] concurrent producer and consumer on the host
+     * -------------------------------------------------------------------------
+     **/
+
+    const uint32_t numof_msgs = 200000;
+
+    std::thread producer([&]() {
+        Msg isr_msg;
+
+        for (uint32_t i = 0; i < numof_msgs; i++)
+        {
+            isr_msg.type = static_cast<uint16_t>(i);
+            isr_msg.content.value = i;
+
+            while (!isr_queue.push(isr_msg))
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t received = 0;
+    uint32_t out_of_order = 0;
+
+    while (received < numof_msgs)
+    {
+        Msg consumed;
+
+        if (isr_queue.pop(&consumed))
+        {
+            if (consumed.content.value != received || consumed.type != static_cast<uint16_t>(received))
+            {
+                out_of_order++;
+            }
+
+            received++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+
+    EXPECT_EQ(received, numof_msgs);
+    EXPECT_EQ(out_of_order, 0);
+    EXPECT_EQ(isr_queue.get_numof_msgs(), 0);
+}
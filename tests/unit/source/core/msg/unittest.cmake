@@ -7,9 +7,11 @@ set(unittest-sources
     ../../source/core/mutex.cpp
     ../../source/core/msg.cpp
     ../../source/core/assert_failure.c
+    ../../source/ztimer/core.c
     stubs/cpu_stub.c
     stubs/thread_stub.c
     stubs/thread_arch_stub.c
+    stubs/ztimer_stub.c
 )
 
 set(unittest-test-sources
@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include "gtest/gtest.h"
+
+#include <vcrtos/heap.h>
+
+#include "core/instance.hpp"
+#include "core/msg.hpp"
+#include "core/msg_buf.hpp"
+#include "core/thread.hpp"
+
+#include "test-threads.hpp"
+
+using namespace vc;
+
+class TestMsgBuf : public TestThreads
+{
+protected:
+    Msg task1_msg_array[4];
+    Msg task2_msg_array[4];
+
+    static void SetUpTestCase()
+    {
+        (void)heap_init();
+    }
+
+    TestMsgBuf(void)
+        : TestThreads(1)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        TestThreads::SetUp();
+
+        /* task2 runs below task1 here */
+        task2_thread = create_thread(task2_stack, 6, "task2");
+
+        for (int i = 0; i < 4; i++)
+        {
+            task1_msg_array[i].init(*instance);
+            task2_msg_array[i].init(*instance);
+        }
+
+        task1_thread->init_msg_queue(task1_msg_array, 4);
+        task2_thread->init_msg_queue(task2_msg_array, 4);
+
+        instance->get<ThreadScheduler>().run();
+    }
+};
+
+TEST_F(TestMsgBuf, pool_alloc_release_test)
+{
+    uint64_t memory[MSG_BUF_POOL_MEMORY_SIZE(32, 3) / sizeof(uint64_t) + 1];
+
+    MsgBufPool pool = MsgBufPool(memory, 32, 3);
+
+    EXPECT_EQ(sizeof(MsgBufPool), sizeof(msg_buf_pool_t));
+    EXPECT_EQ(sizeof(MsgBuf), sizeof(msg_buf_t));
+    EXPECT_EQ(pool.get_numof_free(), 3);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] allocate until the pool is exhausted
+     * -------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(MsgBuf::alloc(*instance, &pool, 33), nullptr);
+
+    MsgBuf *buf1 = MsgBuf::alloc(*instance, &pool, 8);
+    MsgBuf *buf2 = MsgBuf::alloc(*instance, &pool, 32);
+    MsgBuf *buf3 = MsgBuf::alloc(*instance, &pool, 1);
+
+    EXPECT_NE(buf1, nullptr);
+    EXPECT_NE(buf2, nullptr);
+    EXPECT_NE(buf3, nullptr);
+    EXPECT_EQ(MsgBuf::alloc(*instance, &pool, 1), nullptr);
+    EXPECT_EQ(pool.get_numof_free(), 0);
+
+    EXPECT_EQ(buf1->get_size(), 32);
+    EXPECT_EQ(buf1->get_refcount(), 1);
+
+    memset(buf1->get_data(), 0xaa, 32);
+    memset(buf2->get_data(), 0x55, 32);
+
+    EXPECT_EQ(static_cast<uint8_t *>(buf1->get_data())[31], 0xaa);
+    EXPECT_EQ(static_cast<uint8_t *>(buf2->get_data())[0], 0x55);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] buffer goes back to the pool on the last release only
+     * -------------------------------------------------------------------------
+     **/
+
+    buf2->retain();
+
+    EXPECT_EQ(buf2->get_refcount(), 2);
+
+    buf2->release();
+
+    EXPECT_EQ(buf2->get_refcount(), 1);
+    EXPECT_EQ(pool.get_numof_free(), 0);
+
+    buf2->release();
+
+    EXPECT_EQ(pool.get_numof_free(), 1);
+    EXPECT_EQ(MsgBuf::alloc(*instance, &pool, 1), buf2);
+
+    buf1->release();
+    buf2->release();
+    buf3->release();
+
+    EXPECT_EQ(pool.get_numof_free(), 3);
+}
+
+TEST_F(TestMsgBuf, heap_alloc_release_test)
+{
+    const size_t free_size = heap_get_free_size();
+
+    MsgBuf *buf = MsgBuf::alloc(*instance, NULL, 100);
+
+    EXPECT_NE(buf, nullptr);
+    EXPECT_EQ(buf->get_size(), 100);
+    EXPECT_EQ(buf->get_refcount(), 1);
+    EXPECT_LT(heap_get_free_size(), free_size);
+
+    buf->retain();
+    buf->release();
+
+    EXPECT_LT(heap_get_free_size(), free_size);
+
+    buf->release();
+
+    EXPECT_EQ(heap_get_free_size(), free_size);
+}
+
+TEST_F(TestMsgBuf, send_ownership_transfer_test)
+{
+    uint64_t memory[MSG_BUF_POOL_MEMORY_SIZE(16, 2) / sizeof(uint64_t) + 1];
+
+    MsgBufPool pool = MsgBufPool(memory, 16, 2);
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    sleep_and_run(task1_thread);
+    sleep_and_run(task2_thread);
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] main thread sends a buffer to the sleeping task1, the msg is
+     * queued and only the buffer pointer travels
+     * -------------------------------------------------------------------------
+     **/
+
+    MsgBuf *buf = MsgBuf::alloc(*instance, &pool, 16);
+
+    EXPECT_NE(buf, nullptr);
+
+    memcpy(buf->get_data(), "zero-copy", 10);
+
+    Msg msg = Msg(*instance);
+    msg.type = 0x10;
+
+    EXPECT_EQ(buf->try_send(&msg, task1_thread->get_pid()), 1);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 1);
+    EXPECT_EQ(buf->get_refcount(), 1);
+    EXPECT_EQ(MsgBuf::get_outstanding(*instance, main_thread->get_pid()), 1);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] task1 receives the buffer and releases the moved reference
+     * -------------------------------------------------------------------------
+     **/
+
+    wakeup_and_run(task1_thread);
+
+    Msg rmsg = Msg(*instance);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+    EXPECT_EQ(rmsg.type, 0x10);
+    EXPECT_EQ(rmsg.sender_pid, main_thread->get_pid());
+
+    MsgBuf *rbuf = MsgBuf::get(&rmsg);
+
+    EXPECT_EQ(rbuf, buf);
+    EXPECT_STREQ(static_cast<char *>(rbuf->get_data()), "zero-copy");
+
+    rbuf->release();
+
+    EXPECT_EQ(pool.get_numof_free(), 2);
+    EXPECT_EQ(MsgBuf::get_outstanding(*instance, main_thread->get_pid()), 0);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] failed send leaves ownership with the sender
+     * -------------------------------------------------------------------------
+     **/
+
+    sleep_and_run(task1_thread);
+
+    buf = MsgBuf::alloc(*instance, &pool, 16);
+
+    for (int i = 0; i < 4; i++)
+    {
+        Msg fill = Msg(*instance);
+        EXPECT_EQ(fill.try_send(task2_thread->get_pid()), 1);
+    }
+
+    EXPECT_EQ(buf->try_send(&msg, task2_thread->get_pid()), 0);
+    EXPECT_EQ(buf->get_refcount(), 1);
+    EXPECT_EQ(MsgBuf::get_outstanding(*instance, main_thread->get_pid()), 1);
+
+    buf->release();
+
+    EXPECT_EQ(MsgBuf::get_outstanding(*instance, main_thread->get_pid()), 0);
+}
+
+TEST_F(TestMsgBuf, forward_charge_test)
+{
+    uint64_t memory[MSG_BUF_POOL_MEMORY_SIZE(16, 1) / sizeof(uint64_t) + 1];
+
+    MsgBufPool pool = MsgBufPool(memory, 16, 1);
+
+    sleep_and_run(task1_thread);
+    sleep_and_run(task2_thread);
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    MsgBuf *buf = MsgBuf::alloc(*instance, &pool, 16);
+
+    Msg msg = Msg(*instance);
+
+    EXPECT_EQ(buf->try_send(&msg, task1_thread->get_pid()), 1);
+    EXPECT_EQ(MsgBuf::get_outstanding(*instance, main_thread->get_pid()), 1);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] the buffer is charged to the thread that passed it on last
+     * -------------------------------------------------------------------------
+     **/
+
+    wakeup_and_run(task1_thread);
+
+    Msg rmsg = Msg(*instance);
+
+    EXPECT_EQ(rmsg.try_receive(), 1);
+
+    Msg fwd = Msg(*instance);
+
+    EXPECT_EQ(MsgBuf::get(&rmsg)->try_send(&fwd, task2_thread->get_pid()), 1);
+
+    EXPECT_EQ(MsgBuf::get_outstanding(*instance, main_thread->get_pid()), 0);
+    EXPECT_EQ(MsgBuf::get_outstanding(*instance, task1_thread->get_pid()), 1);
+
+    /* counters are kept per instance */
+
+    Instance *other = new Instance();
+
+    EXPECT_EQ(MsgBuf::get_outstanding(*other, task1_thread->get_pid()), 0);
+
+    delete other;
+
+    sleep_and_run(task1_thread);
+    wakeup_and_run(task2_thread);
+
+    Msg rmsg2 = Msg(*instance);
+
+    EXPECT_EQ(rmsg2.try_receive(), 1);
+
+    MsgBuf::get(&rmsg2)->release();
+
+    EXPECT_EQ(MsgBuf::get_outstanding(*instance, task1_thread->get_pid()), 0);
+    EXPECT_EQ(pool.get_numof_free(), 1);
+}
+
+TEST_F(TestMsgBuf, broadcast_test)
+{
+    const size_t free_size = heap_get_free_size();
+
+    sleep_and_run(task1_thread);
+    sleep_and_run(task2_thread);
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] broadcast one heap buffer to task1 and task2, each receiver
+     * holds its own reference and the sender reference is consumed
+     * -------------------------------------------------------------------------
+     **/
+
+    MsgBuf *buf = MsgBuf::alloc(*instance, NULL, 64);
+
+    EXPECT_NE(buf, nullptr);
+
+    kernel_pid_t pids[] = {task1_thread->get_pid(), task2_thread->get_pid()};
+
+    Msg msg = Msg(*instance);
+    msg.type = 0x20;
+
+    EXPECT_EQ(buf->broadcast(&msg, pids, 2), 2);
+    EXPECT_EQ(buf->get_refcount(), 2);
+    EXPECT_EQ(task1_thread->get_numof_msg_in_queue(), 1);
+    EXPECT_EQ(task2_thread->get_numof_msg_in_queue(), 1);
+
+    wakeup_and_run(task1_thread);
+
+    Msg rmsg1 = Msg(*instance);
+
+    EXPECT_EQ(rmsg1.try_receive(), 1);
+    EXPECT_EQ(MsgBuf::get(&rmsg1), buf);
+
+    MsgBuf::get(&rmsg1)->release();
+
+    EXPECT_EQ(buf->get_refcount(), 1);
+    EXPECT_EQ(MsgBuf::get_outstanding(*instance, main_thread->get_pid()), 1);
+
+    sleep_and_run(task1_thread);
+    wakeup_and_run(task2_thread);
+
+    Msg rmsg2 = Msg(*instance);
+
+    EXPECT_EQ(rmsg2.try_receive(), 1);
+    EXPECT_EQ(MsgBuf::get(&rmsg2), buf);
+
+    MsgBuf::get(&rmsg2)->release();
+
+    EXPECT_EQ(heap_get_free_size(), free_size);
+    EXPECT_EQ(MsgBuf::get_outstanding(*instance, main_thread->get_pid()), 0);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] receivers that cannot take the msg do not keep a reference
+     * -------------------------------------------------------------------------
+     **/
+
+    sleep_and_run(task2_thread);
+
+    for (int i = 0; i < 4; i++)
+    {
+        Msg fill = Msg(*instance);
+        EXPECT_EQ(fill.try_send(task2_thread->get_pid()), 1);
+    }
+
+    buf = MsgBuf::alloc(*instance, NULL, 8);
+
+    kernel_pid_t bad_pids[] = {KERNEL_PID_UNDEF, task1_thread->get_pid()};
+
+    EXPECT_EQ(buf->broadcast(&msg, bad_pids, 2), 1);
+    EXPECT_EQ(buf->get_refcount(), 1);
+
+    buf->release();
+
+    EXPECT_EQ(heap_get_free_size(), free_size);
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include "gtest/gtest.h"
+
+#include <vcrtos/cpu.h>
+
+#include "core/instance.hpp"
+#include "core/code_utils.h"
+#include "core/msg.hpp"
+
+#include "test-helper.h"
+
+using namespace vc;
+
+class TestMsgIsrQueue : public testing::Test
+{
+protected:
+    Instance *instance;
+
+    virtual void SetUp()
+    {
+        instance = &Instance::init_single();
+    }
+
+    virtual void TearDown() {}
+};
+
+TEST_F(TestMsgIsrQueue, single_instance_test)
+{
+    EXPECT_FALSE(VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE);
+    EXPECT_TRUE(instance->is_initialized());
+}
+
+TEST_F(TestMsgIsrQueue, cpu_end_of_isr_test)
+{
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    Thread *task1_thread = Thread::init(*instance, task1_stack, sizeof(task1_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "task1");
+
+    ThreadScheduler &scheduler = instance->get<ThreadScheduler>();
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task1_thread);
+
+    Msg isr_msg_array[4];
+    MsgIsrQueue isr_queue;
+
+    isr_queue.init(isr_msg_array, ARRAY_LENGTH(isr_msg_array));
+
+    scheduler.set_msg_isr_queue(task1_thread->get_pid(), &isr_queue);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] isr send to a receive blocked thread is delivered by
+     * cpu_end_of_isr()
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg rmsg = Msg(*instance);
+
+    rmsg.receive();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_BLOCKED);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), main_thread);
+
+    test_helper_reset_pendsv_trigger();
+    test_helper_set_cpu_in_isr();
+
+    Msg msg = Msg(*instance);
+
+    msg.type = 0x11;
+    msg.content.value = 0x12345678;
+
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 1);
+
+    /* Note: the push does not touch the scheduler */
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_BLOCKED);
+    EXPECT_FALSE(scheduler.is_context_switch_requested());
+    EXPECT_EQ(isr_queue.get_numof_msgs(), 1);
+
+    cpu_end_of_isr();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(isr_queue.get_numof_msgs(), 0);
+    EXPECT_TRUE(test_helper_is_pendsv_interrupt_triggered());
+
+    test_helper_reset_cpu_in_isr();
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), task1_thread);
+
+    EXPECT_EQ(rmsg.type, 0x11);
+    EXPECT_EQ(rmsg.content.value, 0x12345678);
+    EXPECT_EQ(rmsg.sender_pid, KERNEL_PID_ISR);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] isr sends to a running thread stay queued in order
+     * -------------------------------------------------------------------------
+     **/
+
+    test_helper_reset_pendsv_trigger();
+    test_helper_set_cpu_in_isr();
+
+    for (uint16_t type = 1; type <= 4; type++)
+    {
+        msg.type = type;
+        EXPECT_EQ(msg.send(task1_thread->get_pid()), 1);
+    }
+
+    msg.type = 5;
+    EXPECT_EQ(msg.send(task1_thread->get_pid()), 0);
+
+    cpu_end_of_isr();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(isr_queue.get_numof_msgs(), 4);
+
+    test_helper_reset_cpu_in_isr();
+
+    for (uint16_t type = 1; type <= 4; type++)
+    {
+        EXPECT_EQ(rmsg.try_receive(), 1);
+        EXPECT_EQ(rmsg.type, type);
+    }
+
+    EXPECT_EQ(rmsg.try_receive(), -1);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] nothing pushed, cpu_end_of_isr() leaves the threads alone
+     * -------------------------------------------------------------------------
+     **/
+
+    rmsg.receive();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_BLOCKED);
+
+    scheduler.run();
+
+    test_helper_set_cpu_in_isr();
+
+    cpu_end_of_isr();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_BLOCKED);
+
+    test_helper_reset_cpu_in_isr();
+
+    scheduler.set_msg_isr_queue(task1_thread->get_pid(), NULL);
+}
@@ -0,0 +1,28 @@
+set(unittest-includes ${unittest-includes}
+)
+
+set(unittest-sources
+    ../../source/core/instance.cpp
+    ../../source/core/api/instance_api.cpp
+    ../../source/core/thread.cpp
+    ../../source/core/mutex.cpp
+    ../../source/core/msg.cpp
+    ../../source/core/assert_failure.c
+    ../../source/ztimer/core.c
+    stubs/cpu_stub.c
+    stubs/thread_stub.c
+    stubs/thread_arch_stub.c
+    stubs/ztimer_stub.c
+)
+
+set(unittest-test-sources
+    source/core/msg_isr_queue/test_msg_isr_queue.cpp
+)
+
+# cpu_end_of_isr() only works on the single instance
+set(unittest-definitions
+    VCRTOS_UNITTEST_SINGLE_INSTANCE
+)
+
+set(CMAKE_C_FLAGS "${CMAKE_C_FLAGS} -DVCRTOS_PROJECT_CONFIG_FILE='\"vcrtos-unittest-config.h\"'")
+set(CMAKE_CXX_FLAGS "${CMAKE_CXX_FLAGS} -DVCRTOS_PROJECT_CONFIG_FILE='\"vcrtos-unittest-config.h\"'")
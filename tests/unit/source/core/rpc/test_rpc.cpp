@@ -0,0 +1,340 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+
+#include "gtest/gtest.h"
+
+#include "core/code_utils.h"
+#include "core/instance.hpp"
+#include "core/msg.hpp"
+#include "core/rpc.hpp"
+#include "core/thread.hpp"
+
+#include "test-threads.hpp"
+
+using namespace vc;
+
+struct AddRequest
+{
+    int32_t a;
+    int32_t b;
+};
+
+struct Sample
+{
+    uint32_t values[16];
+};
+
+struct Add : RpcMethod<AddRequest, int32_t>
+{
+};
+
+struct Negate : RpcMethod<int32_t, int32_t>
+{
+};
+
+struct Fill : RpcMethod<uint32_t, Sample>
+{
+};
+
+typedef RpcService<0x100, Add, Negate, Fill> Calc;
+
+class CalcHandler
+{
+public:
+    CalcHandler(void)
+        : calls(0)
+    {
+    }
+
+    void handle(Add, const AddRequest &request, int32_t &response)
+    {
+        calls++;
+        response = request.a + request.b;
+    }
+
+    void handle(Negate, const int32_t &request, int32_t &response)
+    {
+        calls++;
+        response = -request;
+    }
+
+    void handle(Fill, const uint32_t &request, Sample &response)
+    {
+        calls++;
+
+        for (unsigned i = 0; i < ARRAY_LENGTH(response.values); i++)
+        {
+            response.values[i] = request + i;
+        }
+    }
+
+    int calls;
+};
+
+class TestRpc : public TestThreads
+{
+protected:
+    TestRpc(void)
+        : TestThreads(1)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        TestThreads::SetUp();
+
+        instance->get<ThreadScheduler>().run();
+    }
+
+    /* task1 (server) blocks in receive, main (client) runs */
+    void server_receive(Msg &request)
+    {
+        EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+        request.receive();
+
+        EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RECEIVE_BLOCKED);
+
+        instance->get<ThreadScheduler>().run();
+
+        EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+    }
+};
+
+TEST_F(TestRpc, method_table_test)
+{
+    EXPECT_EQ(Calc::numof_methods, 3);
+
+    EXPECT_EQ(Calc::get_type<Add>(), 0x100);
+    EXPECT_EQ(Calc::get_type<Negate>(), 0x101);
+    EXPECT_EQ(Calc::get_type<Fill>(), 0x102);
+
+    EXPECT_TRUE(Calc::has_type(0x102));
+    EXPECT_FALSE(Calc::has_type(0x103));
+    EXPECT_FALSE(Calc::has_type(0xff));
+
+    EXPECT_TRUE(Add::is_inline);
+    EXPECT_FALSE(Fill::is_inline);
+}
+
+TEST_F(TestRpc, inline_call_test)
+{
+    CalcHandler handler;
+
+    Msg request = Msg(*instance);
+
+    server_receive(request);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] inline request is dispatched and its response replied
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg msg = Msg(*instance);
+    Msg reply = Msg(*instance);
+    RpcFrame frame;
+
+    AddRequest add = {40, 2};
+    int32_t sum = 0;
+
+    Calc::prepare<Add>(msg, add, sum, frame);
+
+    EXPECT_EQ(msg.type, Calc::get_type<Add>());
+    EXPECT_EQ(msg.send_receive(&reply, task1_thread->get_pid()), 1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_REPLY_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    EXPECT_EQ(Calc::dispatch(handler, request), 0);
+    EXPECT_EQ(handler.calls, 1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+
+    EXPECT_EQ(Calc::finish<Add>(reply, sum), 0);
+    EXPECT_EQ(sum, 42);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] msgs of other services are not dispatched
+     * -------------------------------------------------------------------------
+     **/
+
+    request.type = 0x200;
+
+    EXPECT_EQ(Calc::dispatch(handler, request), -1);
+    EXPECT_EQ(handler.calls, 1);
+}
+
+TEST_F(TestRpc, frame_call_test)
+{
+    CalcHandler handler;
+
+    Msg request = Msg(*instance);
+
+    server_receive(request);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] response too large for a msg is written through the frame
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg msg = Msg(*instance);
+    Msg reply = Msg(*instance);
+    RpcFrame frame;
+
+    uint32_t base = 100;
+    Sample sample;
+
+    memset(&sample, 0, sizeof(sample));
+
+    Calc::prepare<Fill>(msg, base, sample, frame);
+
+    EXPECT_EQ(msg.content.ptr, &frame);
+    EXPECT_EQ(msg.send_receive(&reply, task1_thread->get_pid()), 1);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(Calc::dispatch(handler, request), 0);
+    EXPECT_EQ(Calc::finish<Fill>(reply, sample), 0);
+
+    for (uint32_t i = 0; i < ARRAY_LENGTH(sample.values); i++)
+    {
+        EXPECT_EQ(sample.values[i], base + i);
+    }
+}
+
+TEST_F(TestRpc, reject_test)
+{
+    Msg request = Msg(*instance);
+
+    server_receive(request);
+
+    Msg msg = Msg(*instance);
+    Msg reply = Msg(*instance);
+    RpcFrame frame;
+
+    int32_t value = 5;
+    int32_t result = 0;
+
+    Calc::prepare<Negate>(msg, value, result, frame);
+
+    msg.type = 0x300;
+
+    EXPECT_EQ(msg.send_receive(&reply, task1_thread->get_pid()), 1);
+
+    instance->get<ThreadScheduler>().run();
+
+    Calc::reject(request);
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(Calc::finish<Negate>(reply, result), -ENOSYS);
+    EXPECT_EQ(result, 0);
+}
+
+TEST_F(TestRpc, send_receive_timeout_test)
+{
+    instance->get<ThreadScheduler>().sleeping_current_thread();
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] no reply within timeout wakes the client up
+     * -------------------------------------------------------------------------
+     **/
+
+    Msg msg = Msg(*instance);
+    Msg reply = Msg(*instance);
+    MsgTimeout msg_timeout;
+
+    msg.type = Calc::get_type<Negate>();
+
+    EXPECT_EQ(msg.send_receive_timeout(&reply, task1_thread->get_pid(), 1000, &msg_timeout), 1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_REPLY_BLOCKED);
+    EXPECT_NE(task1_thread->msg_waiters.next, nullptr);
+
+    test_helper_ztimer_advance(999);
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_REPLY_BLOCKED);
+    EXPECT_EQ(msg_timeout.timed_out, 0);
+
+    test_helper_ztimer_advance(1);
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(msg_timeout.timed_out, 1);
+    EXPECT_EQ(task1_thread->msg_waiters.next, nullptr);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] a reply before the timeout stops it
+     * -------------------------------------------------------------------------
+     **/
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    instance->get<ThreadScheduler>().wakeup_thread(task1_thread->get_pid());
+    instance->get<ThreadScheduler>().run();
+
+    Msg request = Msg(*instance);
+
+    server_receive(request);
+
+    EXPECT_EQ(msg.send_receive_timeout(&reply, task1_thread->get_pid(), 1000, &msg_timeout), 1);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), task1_thread);
+
+    Msg response = Msg(*instance);
+
+    response.content.value = 7;
+
+    EXPECT_EQ(request.reply(&response), 1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+
+    test_helper_ztimer_advance(1000);
+
+    EXPECT_EQ(msg_timeout.timed_out, 0);
+    EXPECT_EQ(reply.content.value, 7);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] timed call to a missing server fails right away
+     * -------------------------------------------------------------------------
+     **/
+
+    instance->get<ThreadScheduler>().sleeping_current_thread();
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), main_thread);
+
+    RpcClient<Calc> client(*instance, KERNEL_PID_LAST);
+
+    int32_t value = 1;
+    int32_t result = 0;
+
+    EXPECT_EQ(client.call_timeout<Negate>(value, result, 1000), -1);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+}
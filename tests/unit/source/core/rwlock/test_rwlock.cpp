@@ -0,0 +1,449 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+#include <stdio.h>
+
+#include <chrono>
+
+#include "gtest/gtest.h"
+
+#include "core/instance.hpp"
+#include "core/mutex.hpp"
+#include "core/rwlock.hpp"
+#include "core/thread.hpp"
+
+#include "test-threads.hpp"
+
+using namespace vc;
+
+class TestRwLock : public TestThreads
+{
+protected:
+    virtual void SetUp()
+    {
+        TestThreads::SetUp();
+
+        instance->get<ThreadScheduler>().run();
+    }
+};
+
+TEST_F(TestRwLock, constructor_test)
+{
+    EXPECT_TRUE(instance);
+
+    RwLock rwlock = RwLock(*instance);
+
+    EXPECT_EQ(sizeof(RwLock), sizeof(rwlock_t));
+    EXPECT_EQ(rwlock.get_numof_readers(), 0);
+    EXPECT_FALSE(rwlock.is_write_locked());
+}
+
+TEST_F(TestRwLock, try_lock_test)
+{
+    RwLock rwlock = RwLock(*instance);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    EXPECT_EQ(rwlock.try_read_lock(), 1);
+    EXPECT_EQ(rwlock.try_read_lock(), 1);
+    EXPECT_EQ(rwlock.get_numof_readers(), 2);
+    EXPECT_EQ(rwlock.try_write_lock(), 0);
+
+    rwlock.read_unlock();
+    rwlock.read_unlock();
+
+    EXPECT_EQ(rwlock.get_numof_readers(), 0);
+
+    rwlock.read_unlock(); /* not locked, nothing happen */
+
+    EXPECT_EQ(rwlock.get_numof_readers(), 0);
+
+    EXPECT_EQ(rwlock.try_write_lock(), 1);
+    EXPECT_TRUE(rwlock.is_write_locked());
+    EXPECT_EQ(rwlock.try_write_lock(), 0);
+    EXPECT_EQ(rwlock.try_read_lock(), 0);
+
+    rwlock.write_unlock();
+
+    EXPECT_FALSE(rwlock.is_write_locked());
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+}
+
+TEST_F(TestRwLock, writer_preference_test)
+{
+    RwLock rwlock = RwLock(*instance);
+
+    /* task2 hold the read lock */
+
+    rwlock.read_lock();
+
+    EXPECT_EQ(rwlock.get_numof_readers(), 1);
+
+    sleep_and_run(task2_thread);
+
+    /* task1 wants to write, it has to wait for task2 */
+
+    rwlock.write_lock();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] new reader is blocked as soon as a writer is waiting
+     * ------------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    EXPECT_EQ(rwlock.try_read_lock(), 0);
+
+    rwlock.read_lock();
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+    EXPECT_EQ(rwlock.get_numof_readers(), 1);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /* last reader leaving hand the lock over to the writer */
+
+    wakeup_and_run(task2_thread);
+
+    rwlock.read_unlock();
+
+    EXPECT_TRUE(rwlock.is_write_locked());
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->wait_data, nullptr);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    sleep_and_run(task2_thread);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /* writer leaving let the waiting reader in */
+
+    rwlock.write_unlock();
+
+    EXPECT_FALSE(rwlock.is_write_locked());
+    EXPECT_EQ(rwlock.get_numof_readers(), 1);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task3_thread->wait_data, nullptr);
+}
+
+TEST_F(TestRwLock, phase_fair_test)
+{
+    RwLock rwlock = RwLock(*instance);
+
+    /* task2 hold the write lock, task1 and task3 wait to read, main wait to write */
+
+    rwlock.write_lock();
+
+    sleep_and_run(task2_thread);
+
+    rwlock.read_lock();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    rwlock.read_lock();
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    rwlock.write_lock();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(idle_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] writer leaving wakes all waiting readers at once
+     * ------------------------------------------------------------------------------
+     **/
+
+    wakeup_and_run(task2_thread);
+
+    rwlock.write_unlock();
+
+    EXPECT_EQ(rwlock.get_numof_readers(), 2);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    sleep_and_run(task2_thread);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    rwlock.read_unlock();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    sleep_and_run(task1_thread);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    rwlock.read_unlock();
+
+    EXPECT_TRUE(rwlock.is_write_locked());
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+}
+
+TEST_F(TestRwLock, lock_timeout_test)
+{
+    RwLock rwlock = RwLock(*instance);
+
+    WaitTimeout timeout1;
+    WaitTimeout timeout3;
+
+    rwlock.read_lock();
+
+    sleep_and_run(task2_thread);
+
+    rwlock.write_lock_timeout(1000, &timeout1);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    rwlock.read_lock_timeout(2000, &timeout3);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] expired writer let the readers queued behind it in
+     * ------------------------------------------------------------------------------
+     **/
+
+    test_helper_ztimer_advance(999);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    test_helper_ztimer_advance(1);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->wait_data, &rwlock); /* not granted */
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task3_thread->wait_data, nullptr); /* granted */
+    EXPECT_EQ(rwlock.get_numof_readers(), 2);
+
+    /* task3 timer expire after the lock was granted, nothing happen */
+
+    test_helper_ztimer_advance(1000);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(rwlock.get_numof_readers(), 2);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] writer with zero timeout waits until the readers are gone
+     * ------------------------------------------------------------------------------
+     **/
+
+    rwlock.write_lock_timeout(0);
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    test_helper_ztimer_advance(1000000);
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RWLOCK_BLOCKED);
+
+    rwlock.read_unlock();
+    rwlock.read_unlock();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(main_thread->wait_data, nullptr);
+    EXPECT_TRUE(rwlock.is_write_locked());
+}
+
+TEST_F(TestRwLock, contention_benchmark_test)
+{
+    const int iterations = 100000;
+
+    RwLock rwlock = RwLock(*instance);
+    Mutex mutex = Mutex(*instance);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] handoffs needed to let 3 blocked readers in after a writer
+     * ------------------------------------------------------------------------------
+     **/
+
+    Thread *readers[] = {task1_thread, task3_thread, main_thread};
+
+    int rwlock_handoffs = 0;
+    int mutex_handoffs = 0;
+
+    /* rwlock: task2 write, the others read */
+
+    rwlock.write_lock();
+
+    sleep_and_run(task2_thread);
+
+    for (Thread *reader : readers)
+    {
+        EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), reader);
+        rwlock.read_lock();
+        instance->get<ThreadScheduler>().run();
+    }
+
+    wakeup_and_run(task2_thread);
+
+    rwlock.write_unlock();
+
+    rwlock_handoffs++;
+
+    for (Thread *reader : readers)
+    {
+        EXPECT_EQ(reader->get_status(), THREAD_STATUS_PENDING);
+    }
+
+    EXPECT_EQ(rwlock.get_numof_readers(), 3);
+
+    /* readers release the rwlock */
+
+    sleep_and_run(task2_thread);
+
+    for (Thread *reader : readers)
+    {
+        EXPECT_EQ(instance->get<ThreadScheduler>().get_current_active_thread(), reader);
+        rwlock.read_unlock();
+        sleep_and_run(reader);
+    }
+
+    EXPECT_EQ(rwlock.get_numof_readers(), 0);
+
+    for (Thread *reader : readers)
+    {
+        instance->get<ThreadScheduler>().wakeup_thread(reader->get_pid());
+    }
+
+    wakeup_and_run(task2_thread);
+
+    /* mutex: same pattern, readers are serialized */
+
+    mutex.lock();
+
+    sleep_and_run(task2_thread);
+
+    for (size_t i = 0; i < sizeof(readers) / sizeof(readers[0]); i++)
+    {
+        mutex.lock();
+        instance->get<ThreadScheduler>().run();
+    }
+
+    auto numof_blocked = [&readers](thread_status_t status) {
+        int count = 0;
+
+        for (Thread *reader : readers)
+        {
+            count += (reader->get_status() == status);
+        }
+
+        return count;
+    };
+
+    EXPECT_EQ(numof_blocked(THREAD_STATUS_MUTEX_BLOCKED), 3);
+
+    wakeup_and_run(task2_thread);
+
+    mutex.unlock();
+
+    mutex_handoffs++;
+
+    sleep_and_run(task2_thread);
+
+    /* every reader has to unlock before the next one can enter */
+
+    while (instance->get<ThreadScheduler>().get_current_active_thread() != idle_thread)
+    {
+        Thread *reader = instance->get<ThreadScheduler>().get_current_active_thread();
+
+        int blocked = numof_blocked(THREAD_STATUS_MUTEX_BLOCKED);
+
+        mutex.unlock();
+
+        if (numof_blocked(THREAD_STATUS_MUTEX_BLOCKED) < blocked)
+        {
+            mutex_handoffs++;
+        }
+
+        sleep_and_run(reader);
+    }
+
+    EXPECT_EQ(rwlock_handoffs, 1);
+    EXPECT_EQ(mutex_handoffs, 3);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] uncontended lock and unlock cost
+     * ------------------------------------------------------------------------------
+     **/
+
+    wakeup_and_run(task2_thread);
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        mutex.lock();
+        mutex.unlock();
+    }
+
+    auto mutex_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        rwlock.read_lock();
+        rwlock.read_unlock();
+    }
+
+    auto read_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+
+    for (int i = 0; i < iterations; i++)
+    {
+        rwlock.write_lock();
+        rwlock.write_unlock();
+    }
+
+    auto write_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+    printf("[ BENCHMARK] 3 blocked readers: rwlock %d handoff, mutex %d handoffs\n", rwlock_handoffs, mutex_handoffs);
+    printf("[ BENCHMARK] mutex lock/unlock       : %.1f ns\n", static_cast<double>(mutex_ns) / iterations);
+    printf("[ BENCHMARK] rwlock read lock/unlock : %.1f ns\n", static_cast<double>(read_ns) / iterations);
+    printf("[ BENCHMARK] rwlock write lock/unlock: %.1f ns\n", static_cast<double>(write_ns) / iterations);
+
+    EXPECT_EQ(rwlock.get_numof_readers(), 0);
+    EXPECT_FALSE(rwlock.is_write_locked());
+}
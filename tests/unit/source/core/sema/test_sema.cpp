@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <errno.h>
+#include <limits.h>
+
+#include "gtest/gtest.h"
+
+#include "core/instance.hpp"
+#include "core/sema.hpp"
+#include "core/thread.hpp"
+
+#include "test-threads.hpp"
+
+using namespace vc;
+
+class TestSema : public TestThreads
+{
+protected:
+    /* let task2, task1 and task3 block on sema in this order, main thread is
+     * the one running afterward */
+
+    void block_all_tasks(Sema &sema)
+    {
+        instance->get<ThreadScheduler>().run();
+
+        EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+
+        sema.wait();
+
+        EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+
+        instance->get<ThreadScheduler>().run();
+
+        EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+
+        sema.wait();
+
+        EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+
+        instance->get<ThreadScheduler>().run();
+
+        EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RUNNING);
+
+        sema.wait();
+
+        EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+
+        instance->get<ThreadScheduler>().run();
+
+        EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+    }
+};
+
+TEST_F(TestSema, constructor_test)
+{
+    EXPECT_TRUE(instance);
+
+    Sema sema = Sema(*instance, 3);
+
+    EXPECT_EQ(sizeof(Sema), sizeof(sema_t));
+    EXPECT_EQ(sema.get_value(), 3);
+    EXPECT_EQ(sema.peek(), KERNEL_PID_UNDEF);
+}
+
+TEST_F(TestSema, try_wait_test)
+{
+    Sema sema = Sema(*instance, 2);
+
+    EXPECT_EQ(sema.try_wait(), 0);
+    EXPECT_EQ(sema.try_wait(), 0);
+    EXPECT_EQ(sema.get_value(), 0);
+    EXPECT_EQ(sema.try_wait(), -EAGAIN);
+
+    EXPECT_EQ(sema.post(), 0);
+    EXPECT_EQ(sema.get_value(), 1);
+    EXPECT_EQ(sema.wait(), 0);
+    EXPECT_EQ(sema.get_value(), 0);
+
+    Sema full = Sema(*instance, UINT_MAX);
+
+    EXPECT_EQ(full.post(), -EOVERFLOW);
+    EXPECT_EQ(full.get_value(), UINT_MAX);
+}
+
+TEST_F(TestSema, post_wake_one_waiter_test)
+{
+    Sema sema = Sema(*instance, 0);
+
+    block_all_tasks(sema);
+
+    /* Note: waiters are ordered by priority, not by arrival */
+
+    EXPECT_EQ(sema.peek(), task2_thread->get_pid());
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] each post wake up exactly one highest priority waiter
+     * ------------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(sema.post(), 0);
+
+    EXPECT_EQ(sema.get_value(), 0); /* token handed directly to task2 */
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+    EXPECT_EQ(sema.peek(), task1_thread->get_pid());
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+
+    /* post burst from task2 wakes task1 and task3, one each */
+
+    EXPECT_EQ(sema.post(), 0);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+
+    EXPECT_EQ(sema.post(), 0);
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(sema.peek(), KERNEL_PID_UNDEF);
+    EXPECT_EQ(sema.get_value(), 0);
+
+    /* no more waiter, post increments the value */
+
+    EXPECT_EQ(sema.post(), 0);
+
+    EXPECT_EQ(sema.get_value(), 1);
+
+    /* main thread can not steal the tokens handed to task1 and task3 */
+
+    EXPECT_EQ(sema.try_wait(), 0);
+    EXPECT_EQ(sema.try_wait(), -EAGAIN);
+}
+
+TEST_F(TestSema, post_from_isr_test)
+{
+    Sema sema = Sema(*instance, 0);
+
+    block_all_tasks(sema);
+
+    test_helper_set_cpu_in_isr();
+
+    EXPECT_EQ(sema.post(), 0);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_TRUE(instance->get<ThreadScheduler>().is_context_switch_requested());
+
+    test_helper_reset_cpu_in_isr();
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+}
+
+TEST_F(TestSema, wait_timed_test)
+{
+    Sema sema = Sema(*instance, 0);
+
+    WaitTimeout timeout1;
+    WaitTimeout timeout2;
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    sema.wait_timed(1000, &timeout2);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    sema.wait_timed(500, &timeout1);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] waiter expired by timeout is removed from the queue
+     * ------------------------------------------------------------------------------
+     **/
+
+    test_helper_ztimer_advance(499);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+
+    test_helper_ztimer_advance(1);
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task1_thread->wait_data, &sema); /* not granted */
+    EXPECT_EQ(sema.peek(), task2_thread->get_pid());
+    EXPECT_EQ(sema.get_value(), 0);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] timeout after the waiter was granted has no effect
+     * ------------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(sema.post(), 0);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+    EXPECT_EQ(sema.peek(), KERNEL_PID_UNDEF);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    test_helper_ztimer_advance(500);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(sema.get_value(), 0);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] zero timeout waits until the semaphore is posted
+     * ------------------------------------------------------------------------------
+     **/
+
+    sema.wait_timed(0);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+
+    test_helper_ztimer_advance(1000000);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_SEMA_BLOCKED);
+    EXPECT_EQ(sema.peek(), task2_thread->get_pid());
+
+    EXPECT_EQ(sema.post(), 0);
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->wait_data, nullptr);
+    EXPECT_EQ(sema.get_value(), 0);
+}
+
+TEST_F(TestSema, destroy_test)
+{
+    Sema sema = Sema(*instance, 0);
+
+    block_all_tasks(sema);
+
+    sema.destroy();
+
+    /* Note: all waiters are released and see the semaphore canceled */
+
+    EXPECT_EQ(task1_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task3_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(task2_thread->wait_data, &sema);
+    EXPECT_EQ(sema.peek(), KERNEL_PID_UNDEF);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    EXPECT_EQ(sema.try_wait(), -ECANCELED);
+    EXPECT_EQ(sema.wait(), -ECANCELED);
+    EXPECT_EQ(task2_thread->get_status(), THREAD_STATUS_RUNNING);
+}
@@ -1372,9 +1372,8 @@ TEST_F(TestThread, thread_event_test)
     EXPECT_EQ(queue.event_wait(), &event1);
     queue.event_release(&event1);
 
-    /* Note: [IMPORTANT] event_wait() need to release the event manually before
-     * it can be reuse, and make sure the event is not in the queue when you
-     * release it */
+    /* Note: event_wait() release the event the same as event_get(), calling
+     * event_release() on event that is no longer in the queue is harmless */
 
     EXPECT_EQ(queue.event_wait(), nullptr); /* nothing on the queue */
 
@@ -1646,6 +1645,69 @@ TEST_F(TestThread, thread_event_test)
     EXPECT_EQ(idle_thread->get_status(), THREAD_STATUS_PENDING);
     EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_FLAG_BLOCKED_ANY);
 
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] cancel first, middle and last event in the queue
+     * ------------------------------------------------------------------------------
+     **/
+
+    queue.event_post(&event1, event_thread);
+    queue.event_post(&event2, event_thread);
+    queue.event_post(&event3, event_thread);
+    queue.event_post(&event4, event_thread);
+    queue.event_post(&event5, event_thread);
+
+    EXPECT_EQ(queue.event_pending(), 5);
+    EXPECT_EQ(queue.event_peek(), &event1);
+
+    queue.event_cancel(&event5); /* last */
+
+    EXPECT_EQ(queue.event_pending(), 4);
+    EXPECT_EQ(event5.list_node.next, nullptr);
+    EXPECT_EQ(event5.list_node.prev, nullptr);
+
+    queue.event_cancel(&event1); /* first */
+
+    EXPECT_EQ(queue.event_pending(), 3);
+    EXPECT_EQ(queue.event_peek(), &event2);
+
+    queue.event_cancel(&event3); /* middle */
+
+    EXPECT_EQ(queue.event_pending(), 2);
+    EXPECT_EQ(queue.event_peek(), &event2);
+
+    queue.event_cancel(&event3); /* not in the queue, nothing to do */
+
+    EXPECT_EQ(queue.event_pending(), 2);
+
+    queue.event_post(&event5, event_thread);
+
+    EXPECT_EQ(queue.event_pending(), 3);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(idle_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    EXPECT_EQ(queue.event_get(), &event2);
+    EXPECT_EQ(queue.event_get(), &event4);
+    EXPECT_EQ(queue.event_get(), &event5);
+    EXPECT_EQ(queue.event_get(), nullptr);
+
+    EXPECT_EQ(queue.event_pending(), 0);
+    EXPECT_EQ(queue.event_peek(), nullptr);
+
+    instance->get<ThreadScheduler>().thread_flags_clear(0xffff);
+
+    EXPECT_EQ(queue.event_wait(), nullptr);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(idle_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_FLAG_BLOCKED_ANY);
+
     typedef struct
     {
         event_t super;
@@ -1694,3 +1756,294 @@ TEST_F(TestThread, thread_event_test)
 
     EXPECT_EQ(sizeof(struct process), sizeof(thread_t));
 }
+
+TEST_F(TestThread, thread_event_batch_test)
+{
+    instance_reset();
+
+    char idle_stack[128];
+
+    Thread *idle_thread = Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "idle");
+
+    char main_stack[128];
+
+    Thread *main_thread = Thread::init(*instance, main_stack, sizeof(main_stack), 7,
+                                       THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                       NULL, NULL, "main");
+
+    char event_stack[128];
+
+    Thread *event_thread = Thread::init(*instance, event_stack, sizeof(event_stack), 5,
+                                        THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                        NULL, NULL, "event");
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(idle_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    EventQueue queue = EventQueue(*instance);
+
+    EXPECT_FALSE(queue.is_coalesce());
+    EXPECT_EQ(queue.get_stats().posts, 0);
+    EXPECT_EQ(queue.get_stats().wakeups, 0);
+    EXPECT_EQ(queue.get_stats().events, 0);
+    EXPECT_EQ(queue.get_events_per_wakeup(), 0);
+
+    EventBatch batch;
+
+    EXPECT_EQ(sizeof(EventBatch), sizeof(event_batch_t));
+    EXPECT_EQ(sizeof(event_t), sizeof(dlist_node_t) + sizeof(event_handler_func_t));
+    EXPECT_EQ(offsetof(event_t, handler), sizeof(dlist_node_t));
+    EXPECT_TRUE(batch.is_empty());
+    EXPECT_EQ(batch.event_get(), nullptr);
+
+    EXPECT_EQ(queue.event_wait_batch(&batch), 0); /* nothing in the queue, event_thread blocked */
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(idle_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_FLAG_BLOCKED_ANY);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] post multiple events without coalescing
+     * ------------------------------------------------------------------------------
+     **/
+
+    Event event1 = Event();
+    Event event2 = Event();
+    Event event3 = Event();
+    Event event4 = Event();
+
+    queue.event_post(&event1, event_thread);
+    queue.event_post(&event2, event_thread);
+    queue.event_post(&event3, event_thread);
+
+    /* Note: every post signal the event thread */
+
+    EXPECT_EQ(queue.get_stats().posts, 3);
+    EXPECT_EQ(queue.get_stats().wakeups, 3);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    EXPECT_EQ(queue.event_wait_batch(&batch), 3);
+
+    /* Note: the whole queue is claimed by the batch, the events stay queued
+     * until the batch hands them out */
+
+    EXPECT_EQ(queue.event_pending(), 3);
+    EXPECT_EQ(queue.event_peek(), &event1);
+    EXPECT_FALSE(batch.is_empty());
+
+    /* posting event that is still in the batch has no effect */
+
+    queue.event_post(&event2, event_thread);
+
+    EXPECT_EQ(queue.event_pending(), 3);
+
+    /* posting new event while draining the batch goes to the queue */
+
+    queue.event_post(&event4, event_thread);
+
+    EXPECT_EQ(queue.event_pending(), 4);
+
+    EXPECT_EQ(batch.event_get(), &event1);
+    EXPECT_EQ(event1.list_node.next, nullptr);
+    EXPECT_EQ(batch.event_get(), &event2);
+    EXPECT_EQ(batch.event_get(), &event3);
+    EXPECT_EQ(batch.event_get(), nullptr);
+    EXPECT_TRUE(batch.is_empty());
+    EXPECT_EQ(queue.event_pending(), 1);
+
+    EXPECT_EQ(queue.event_get_batch(&batch), 1);
+    EXPECT_EQ(batch.event_get(), &event4);
+    EXPECT_EQ(batch.event_get(), nullptr);
+
+    EXPECT_EQ(queue.get_stats().posts, 5);
+    EXPECT_EQ(queue.get_stats().wakeups, 5);
+    EXPECT_EQ(queue.get_stats().events, 4);
+
+    instance->get<ThreadScheduler>().thread_flags_clear(0xffff);
+
+    EXPECT_EQ(queue.event_wait_batch(&batch), 0);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_FLAG_BLOCKED_ANY);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] post multiple events with coalescing
+     * ------------------------------------------------------------------------------
+     **/
+
+    queue.reset_stats();
+    queue.set_coalesce(true);
+
+    EXPECT_TRUE(queue.is_coalesce());
+
+    queue.event_post(&event1, event_thread);
+
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_NE(event_thread->flags & THREAD_FLAG_EVENT, 0);
+
+    queue.event_post(&event2, event_thread);
+    queue.event_post(&event3, event_thread);
+    queue.event_post(&event4, event_thread);
+
+    /* Note: wakeup is still pending, only the first post signal the thread */
+
+    EXPECT_EQ(queue.get_stats().posts, 4);
+    EXPECT_EQ(queue.get_stats().wakeups, 1);
+    EXPECT_EQ(queue.event_pending(), 4);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    EXPECT_EQ(queue.event_wait_batch(&batch), 4);
+
+    EXPECT_EQ(batch.event_get(), &event1);
+    EXPECT_EQ(batch.event_get(), &event2);
+    EXPECT_EQ(batch.event_get(), &event3);
+    EXPECT_EQ(batch.event_get(), &event4);
+    EXPECT_EQ(batch.event_get(), nullptr);
+
+    EXPECT_EQ(queue.get_stats().events, 4);
+    EXPECT_EQ(queue.get_events_per_wakeup(), 4);
+
+    /* Note: THREAD_FLAG_EVENT still set, next wait consume it without
+     * blocking, and the following wait block the event thread */
+
+    EXPECT_EQ(queue.event_wait_batch(&batch), 0);
+
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(event_thread->flags & THREAD_FLAG_EVENT, 0);
+
+    EXPECT_EQ(queue.event_wait_batch(&batch), 0);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_FLAG_BLOCKED_ANY);
+
+    /* blocked event thread must always be signaled */
+
+    queue.event_post(&event1, event_thread);
+
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(queue.get_stats().wakeups, 2);
+
+    instance->get<ThreadScheduler>().run();
+
+    EXPECT_EQ(event_thread->get_status(), THREAD_STATUS_RUNNING);
+
+    EXPECT_EQ(queue.event_wait(), &event1);
+    EXPECT_EQ(queue.get_stats().events, 5);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] cancel events sitting in a batch
+     * ------------------------------------------------------------------------------
+     **/
+
+    Event event5 = Event();
+
+    queue.event_post(&event1, event_thread);
+    queue.event_post(&event2, event_thread);
+    queue.event_post(&event3, event_thread);
+    queue.event_post(&event4, event_thread);
+
+    EXPECT_EQ(queue.event_get_batch(&batch), 4);
+
+    queue.event_post(&event5, event_thread);
+
+    EXPECT_EQ(queue.event_pending(), 5);
+
+    queue.event_cancel(&event4); /* last */
+    queue.event_cancel(&event2); /* middle */
+
+    EXPECT_EQ(queue.event_pending(), 3);
+    EXPECT_EQ(queue.event_peek(), &event1);
+    EXPECT_FALSE(event4.is_queued());
+    EXPECT_FALSE(event2.is_queued());
+
+    EXPECT_EQ(batch.event_get(), &event1);
+    EXPECT_EQ(batch.event_get(), &event3);
+    EXPECT_EQ(batch.event_get(), nullptr);
+
+    EXPECT_EQ(queue.event_get(), &event5);
+    EXPECT_EQ(queue.event_pending(), 0);
+
+    /* the only event of the batch */
+
+    queue.event_post(&event1, event_thread);
+
+    EXPECT_EQ(queue.event_get_batch(&batch), 1);
+
+    queue.event_cancel(&event1);
+
+    EXPECT_TRUE(batch.is_empty());
+    EXPECT_EQ(queue.event_pending(), 0);
+
+    /* cancelled event can be posted again */
+
+    queue.event_post(&event4, event_thread);
+
+    EXPECT_EQ(queue.event_pending(), 1);
+    EXPECT_EQ(queue.event_get(), &event4);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] cancel event posted after the batch was taken
+     * ------------------------------------------------------------------------------
+     **/
+
+    queue.event_post(&event1, event_thread);
+    queue.event_post(&event2, event_thread);
+
+    EXPECT_EQ(queue.event_get_batch(&batch), 2);
+
+    queue.event_post(&event3, event_thread);
+    queue.event_post(&event4, event_thread);
+
+    queue.event_cancel(&event3);
+
+    /* Note: the batch gives up its last claim, event2 is left in the queue
+     * and the batch never hands out event4 */
+
+    EXPECT_EQ(queue.event_pending(), 3);
+    EXPECT_EQ(batch.event_get(), &event1);
+    EXPECT_EQ(batch.event_get(), nullptr);
+    EXPECT_TRUE(batch.is_empty());
+
+    EXPECT_EQ(queue.event_get(), &event2);
+    EXPECT_EQ(queue.event_get(), &event4);
+    EXPECT_EQ(queue.event_get(), nullptr);
+
+    /**
+     * ------------------------------------------------------------------------------
+     * [TEST CASE] get events of a batch straight from the queue
+     * ------------------------------------------------------------------------------
+     **/
+
+    queue.event_post(&event1, event_thread);
+    queue.event_post(&event2, event_thread);
+
+    EXPECT_EQ(queue.event_get_batch(&batch), 2);
+
+    EXPECT_EQ(queue.event_get(), &event1);
+    EXPECT_EQ(batch.event_get(), &event2);
+    EXPECT_EQ(batch.event_get(), nullptr);
+    EXPECT_EQ(queue.event_pending(), 0);
+}
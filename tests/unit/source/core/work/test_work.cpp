@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include "gtest/gtest.h"
+
+#include "core/instance.hpp"
+#include "core/thread.hpp"
+#include "core/work.hpp"
+
+#include "test-threads.hpp"
+
+using namespace vc;
+
+static WorkQueue *test_work_queue;
+static int work_handler_count;
+static int work_resubmit_count;
+static int event_handler_count;
+
+static void work_handler(work_t *work)
+{
+    (void) work;
+    work_handler_count++;
+}
+
+static void work_resubmit_handler(work_t *work)
+{
+    Work *w = static_cast<Work *>(work);
+
+    if (++work_resubmit_count < 3)
+    {
+        EXPECT_EQ(w->submit(test_work_queue), 1);
+    }
+}
+
+static void event_handler(event_t *event)
+{
+    (void) event;
+    event_handler_count++;
+}
+
+class TestWork : public TestThreads
+{
+protected:
+    WorkQueue *queue;
+
+    Thread *work_thread;
+
+    TestWork(void)
+        : TestThreads(1)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        TestThreads::SetUp();
+
+        work_handler_count = 0;
+        work_resubmit_count = 0;
+        event_handler_count = 0;
+
+        work_thread = task1_thread;
+
+        queue = new WorkQueue(*instance);
+        queue->set_thread(work_thread);
+
+        test_work_queue = queue;
+
+        /* let the work queue thread run and block waiting for event */
+
+        instance->get<ThreadScheduler>().run();
+
+        EXPECT_EQ(work_thread->get_status(), THREAD_STATUS_RUNNING);
+
+        queue->run();
+
+        EXPECT_EQ(work_thread->get_status(), THREAD_STATUS_FLAG_BLOCKED_ANY);
+
+        instance->get<ThreadScheduler>().run();
+
+        EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+    }
+
+    virtual void TearDown()
+    {
+        delete queue;
+        TestThreads::TearDown();
+    }
+
+    void run_work_queue(void)
+    {
+        instance->get<ThreadScheduler>().run();
+
+        EXPECT_EQ(work_thread->get_status(), THREAD_STATUS_RUNNING);
+
+        /* Note: on unittest build event_loop() return once the queue is
+         * drained, call it again until the work queue thread is blocked */
+
+        do
+        {
+            queue->run();
+        } while (work_thread->get_status() == THREAD_STATUS_RUNNING);
+
+        EXPECT_EQ(work_thread->get_status(), THREAD_STATUS_FLAG_BLOCKED_ANY);
+
+        instance->get<ThreadScheduler>().run();
+
+        EXPECT_EQ(main_thread->get_status(), THREAD_STATUS_RUNNING);
+    }
+};
+
+TEST_F(TestWork, constructor_test)
+{
+    EXPECT_TRUE(instance);
+    EXPECT_TRUE(queue);
+    EXPECT_EQ(sizeof(WorkQueue), sizeof(work_queue_t));
+    EXPECT_EQ(sizeof(Work), sizeof(work_t));
+}
+
+TEST_F(TestWork, event_loop_test)
+{
+    Event event1 = Event(event_handler);
+    Event event2 = Event(event_handler);
+
+    queue->get_event_queue().event_post(&event1, work_thread);
+    queue->get_event_queue().event_post(&event2, work_thread);
+    queue->get_event_queue().event_post(&event1, work_thread);
+
+    EXPECT_EQ(queue->get_event_queue().event_pending(), 2);
+    EXPECT_EQ(work_thread->get_status(), THREAD_STATUS_PENDING);
+
+    run_work_queue();
+
+    EXPECT_EQ(event_handler_count, 2);
+    EXPECT_EQ(queue->get_event_queue().event_pending(), 0);
+    EXPECT_EQ(event1.list_node.next, nullptr);
+    EXPECT_EQ(event2.list_node.next, nullptr);
+}
+
+TEST_F(TestWork, submit_test)
+{
+    Work work = Work(work_handler);
+
+    EXPECT_FALSE(work.is_pending());
+
+    EXPECT_EQ(work.submit(queue), 1);
+
+    EXPECT_TRUE(work.is_pending());
+    EXPECT_TRUE(work.is_queued());
+    EXPECT_FALSE(work.is_scheduled());
+    EXPECT_EQ(work_thread->get_status(), THREAD_STATUS_PENDING);
+
+    /* Note: submit already pending work is a no-op */
+
+    EXPECT_EQ(work.submit(queue), 0);
+    EXPECT_EQ(queue->get_event_queue().event_pending(), 1);
+
+    run_work_queue();
+
+    EXPECT_EQ(work_handler_count, 1);
+    EXPECT_FALSE(work.is_pending());
+
+    /* work can be submitted again after the handler has run */
+
+    EXPECT_EQ(work.submit(queue), 1);
+
+    run_work_queue();
+
+    EXPECT_EQ(work_handler_count, 2);
+}
+
+TEST_F(TestWork, resubmit_from_handler_test)
+{
+    Work work = Work(work_resubmit_handler);
+
+    EXPECT_EQ(work.submit(queue), 1);
+
+    run_work_queue();
+
+    EXPECT_EQ(work_resubmit_count, 3);
+    EXPECT_FALSE(work.is_pending());
+}
+
+TEST_F(TestWork, schedule_test)
+{
+    Work work = Work(work_handler);
+
+    EXPECT_EQ(work.schedule(queue, 1000), 1);
+
+    EXPECT_TRUE(work.is_pending());
+    EXPECT_TRUE(work.is_scheduled());
+    EXPECT_FALSE(work.is_queued());
+
+    /* Note: schedule already pending work keep the previous deadline */
+
+    EXPECT_EQ(work.schedule(queue, 10), 0);
+
+    test_helper_ztimer_advance(999);
+
+    EXPECT_FALSE(work.is_queued());
+    EXPECT_EQ(work_thread->get_status(), THREAD_STATUS_FLAG_BLOCKED_ANY);
+
+    test_helper_ztimer_advance(1);
+
+    EXPECT_TRUE(work.is_queued());
+    EXPECT_FALSE(work.is_scheduled());
+    EXPECT_EQ(work_thread->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_TRUE(instance->get<ThreadScheduler>().is_context_switch_requested());
+
+    run_work_queue();
+
+    EXPECT_EQ(work_handler_count, 1);
+    EXPECT_FALSE(work.is_pending());
+
+    /* zero delay is an immediate submit */
+
+    EXPECT_EQ(work.schedule(queue, 0), 1);
+    EXPECT_TRUE(work.is_queued());
+
+    run_work_queue();
+
+    EXPECT_EQ(work_handler_count, 2);
+}
+
+TEST_F(TestWork, reschedule_test)
+{
+    Work work = Work(work_handler);
+
+    EXPECT_EQ(work.schedule(queue, 1000), 1);
+
+    test_helper_ztimer_advance(500);
+
+    EXPECT_EQ(work.reschedule(queue, 1000), 1);
+
+    test_helper_ztimer_advance(600);
+
+    EXPECT_FALSE(work.is_queued());
+    EXPECT_TRUE(work.is_scheduled());
+
+    test_helper_ztimer_advance(400);
+
+    EXPECT_TRUE(work.is_queued());
+
+    /* reschedule a queued work move it back to the timer */
+
+    EXPECT_EQ(work.reschedule(queue, 100), 1);
+
+    EXPECT_FALSE(work.is_queued());
+    EXPECT_TRUE(work.is_scheduled());
+    EXPECT_EQ(queue->get_event_queue().event_pending(), 0);
+
+    test_helper_ztimer_advance(100);
+
+    run_work_queue();
+
+    EXPECT_EQ(work_handler_count, 1);
+}
+
+TEST_F(TestWork, submit_scheduled_work_test)
+{
+    Work work = Work(work_handler);
+
+    EXPECT_EQ(work.schedule(queue, 1000), 1);
+
+    EXPECT_EQ(work.submit(queue), 1);
+
+    EXPECT_TRUE(work.is_queued());
+    EXPECT_FALSE(work.is_scheduled());
+
+    run_work_queue();
+
+    EXPECT_EQ(work_handler_count, 1);
+
+    /* the timer was removed, nothing more to run */
+
+    test_helper_ztimer_advance(2000);
+
+    EXPECT_FALSE(work.is_pending());
+    EXPECT_EQ(work_thread->get_status(), THREAD_STATUS_FLAG_BLOCKED_ANY);
+}
+
+TEST_F(TestWork, cancel_test)
+{
+    Work work1 = Work(work_handler);
+    Work work2 = Work(work_handler);
+    Work work3 = Work(work_handler);
+
+    EXPECT_EQ(work1.cancel(), 0);
+
+    EXPECT_EQ(work1.schedule(queue, 1000), 1);
+    EXPECT_EQ(work2.schedule(queue, 2000), 1);
+
+    EXPECT_EQ(work1.cancel(), 1);
+    EXPECT_EQ(work1.cancel(), 0);
+
+    test_helper_ztimer_advance(1500);
+
+    EXPECT_FALSE(work1.is_pending());
+    EXPECT_TRUE(work2.is_scheduled());
+
+    EXPECT_EQ(work3.submit(queue), 1);
+    EXPECT_EQ(work1.submit(queue), 1);
+
+    EXPECT_EQ(work3.cancel(), 1);
+
+    EXPECT_EQ(queue->get_event_queue().event_pending(), 1);
+
+    test_helper_ztimer_advance(500);
+
+    EXPECT_EQ(queue->get_event_queue().event_pending(), 2);
+
+    run_work_queue();
+
+    EXPECT_EQ(work_handler_count, 2);
+    EXPECT_FALSE(work1.is_pending());
+    EXPECT_FALSE(work2.is_pending());
+    EXPECT_FALSE(work3.is_pending());
+}
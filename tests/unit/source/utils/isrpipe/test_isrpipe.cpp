@@ -15,12 +15,18 @@
  * Authors: Darko Pancev <darko.pancev@vertexcom.com>
  */
 
+#include <stdio.h>
+
+#include <chrono>
+
 #include "gtest/gtest.h"
 
 #include "core/instance.hpp"
 
 #include "utils/isrpipe.hpp"
 
+#include "test-helper.h"
+
 using namespace vc;
 using namespace utils;
 
@@ -278,3 +284,458 @@ TEST_F(TestUtilsUartIsrpipe, functions_test)
     EXPECT_EQ(thread1->get_status(), THREAD_STATUS_PENDING);
     EXPECT_EQ(thread2->get_status(), THREAD_STATUS_RUNNING);
 }
+
+TEST_F(TestUtilsTsrb, bulk_wrap_around_test)
+{
+    char data[6] = {0x1, 0x2, 0x3, 0x4, 0x5, 0x6};
+    char result[8];
+
+    /* move the counters close to the end of the buffer */
+
+    EXPECT_EQ(tsrb->add(data, 6), 6);
+    EXPECT_EQ(tsrb->drop(6), 6);
+
+    EXPECT_EQ(tsrb->add(data, sizeof(data)), 6);
+    EXPECT_EQ(tsrb->add(data, sizeof(data)), 2); /* only 2 bytes free */
+    EXPECT_TRUE(tsrb->is_full());
+
+    EXPECT_EQ(tsrb->get(result, sizeof(result)), 8);
+    EXPECT_TRUE(tsrb->is_empty());
+
+    char expected[8] = {0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x1, 0x2};
+
+    EXPECT_EQ(memcmp(result, expected, sizeof(expected)), 0);
+
+    EXPECT_EQ(tsrb->get(result, sizeof(result)), 0);
+    EXPECT_EQ(tsrb->drop(1), 0);
+
+    EXPECT_EQ(tsrb->add(data, 5), 5);
+    EXPECT_EQ(tsrb->drop(3), 3);
+    EXPECT_EQ(tsrb->get_one(), 0x4);
+    EXPECT_EQ(tsrb->get(result, 1), 1);
+    EXPECT_EQ(result[0], 0x5);
+}
+
+TEST(TestUtilsTsrbBenchmark, throughput_benchmark_test)
+{
+    static char buffer[2048];
+    static char data[1024];
+    static char result[1024];
+
+    const size_t transfer_sizes[] = {1, 64, 1024};
+    const size_t bytes_per_run = 4 * 1024 * 1024;
+
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<char>(i);
+    }
+
+    for (size_t size : transfer_sizes)
+    {
+        Tsrb tsrb(buffer, sizeof(buffer));
+
+        /* odd start offset so transfers keep crossing the buffer end */
+        tsrb.add(data, 3);
+        tsrb.drop(3);
+
+        auto start = std::chrono::steady_clock::now();
+
+        for (size_t done = 0; done < bytes_per_run; done += size)
+        {
+            for (size_t n = 0; n < size; n++)
+            {
+                tsrb.add_one(data[n]);
+            }
+
+            for (size_t n = 0; n < size; n++)
+            {
+                result[n] = static_cast<char>(tsrb.get_one());
+            }
+        }
+
+        std::chrono::nanoseconds bytewise = std::chrono::steady_clock::now() - start;
+
+        size_t transferred = 0;
+
+        start = std::chrono::steady_clock::now();
+
+        for (size_t done = 0; done < bytes_per_run; done += size)
+        {
+            tsrb.add(data, size);
+            transferred += tsrb.get(result, size);
+        }
+
+        std::chrono::nanoseconds bulk = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ(transferred, bytes_per_run);
+
+        EXPECT_EQ(memcmp(result, data, size), 0);
+        EXPECT_TRUE(tsrb.is_empty());
+
+        printf("[ BENCHMARK] tsrb %4zu byte transfers : bytewise %7.1f MB/s, bulk %7.1f MB/s\n", size,
+               static_cast<double>(bytes_per_run) / bytewise.count() * 1000.0,
+               static_cast<double>(bytes_per_run) / bulk.count() * 1000.0);
+    }
+}
+
+TEST_F(TestUtilsTsrb, zero_copy_test)
+{
+    RingSpan span;
+
+    EXPECT_EQ(tsrb->write_reserve(&span), 8);
+    EXPECT_EQ(span.data[0], buffer);
+    EXPECT_EQ(span.size[0], 8);
+    EXPECT_EQ(span.size[1], 0);
+
+    EXPECT_EQ(tsrb->read_peek(&span), 0);
+
+    memcpy(span.data[0], "abcdef", 6);
+
+    /* nothing is readable before the commit */
+
+    EXPECT_TRUE(tsrb->is_empty());
+
+    tsrb->write_commit(6);
+
+    EXPECT_EQ(tsrb->avail(), 6);
+
+    EXPECT_EQ(tsrb->read_peek(&span), 6);
+    EXPECT_EQ(memcmp(span.data[0], "abcdef", 6), 0);
+    EXPECT_EQ(span.size[1], 0);
+
+    tsrb->read_release(5);
+
+    EXPECT_EQ(tsrb->avail(), 1);
+
+    /* free storage wraps around the end */
+
+    EXPECT_EQ(tsrb->write_reserve(&span), 7);
+    EXPECT_EQ(span.data[0], buffer + 6);
+    EXPECT_EQ(span.size[0], 2);
+    EXPECT_EQ(span.data[1], buffer);
+    EXPECT_EQ(span.size[1], 5);
+
+    memcpy(span.data[0], "gh", 2);
+    memcpy(span.data[1], "ijk", 3);
+
+    tsrb->write_commit(5);
+
+    EXPECT_EQ(tsrb->read_peek(&span), 6);
+    EXPECT_EQ(span.data[0], buffer + 5);
+    EXPECT_EQ(span.size[0], 3);
+    EXPECT_EQ(span.data[1], buffer);
+    EXPECT_EQ(span.size[1], 3);
+
+    EXPECT_EQ(memcmp(span.data[0], "fgh", 3), 0);
+    EXPECT_EQ(memcmp(span.data[1], "ijk", 3), 0);
+
+    tsrb->read_release(span.total());
+
+    EXPECT_TRUE(tsrb->is_empty());
+    EXPECT_EQ(tsrb->free(), 8);
+}
+
+TEST_F(TestUtilsUartIsrpipe, wakeup_policy_test)
+{
+    char idle_stack[128];
+    char reader_stack[128];
+
+    test_helper_ztimer_reset();
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *reader = Thread::init(*instance, reader_stack, sizeof(reader_stack), 5,
+                                  THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                  NULL, NULL, "reader");
+
+    ThreadScheduler &scheduler = instance->get<ThreadScheduler>();
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), reader);
+
+    char data[64];
+
+    memset(data, 'a', sizeof(data));
+
+    /* Note: on unittest build read() locks the mutex once, the first empty
+     * read takes the unlocked mutex, the next one blocks */
+
+    EXPECT_EQ(uart_isrpipe->read(data, sizeof(data)), 0);
+    EXPECT_EQ(uart_isrpipe->read(data, sizeof(data)), 0);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    scheduler.run();
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] reader is woken once the threshold is reached
+     * -------------------------------------------------------------------------
+     **/
+
+    uart_isrpipe->set_wakeup_threshold(4);
+
+    for (int i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(uart_isrpipe->write_one('a'), 0);
+    }
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+    EXPECT_EQ(uart_isrpipe->get_stats().wakeups, 0);
+
+    EXPECT_EQ(uart_isrpipe->write_one('a'), 0);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(uart_isrpipe->get_stats().wakeups, 1);
+    EXPECT_EQ(uart_isrpipe->get_stats().bytes, 4);
+
+    scheduler.run();
+
+    EXPECT_EQ(uart_isrpipe->read(data, sizeof(data)), 4);
+    EXPECT_EQ(uart_isrpipe->read(data, sizeof(data)), 0);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    scheduler.run();
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] bulk write signals the reader only once
+     * -------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(uart_isrpipe->write(data, sizeof(data)), 64);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(uart_isrpipe->get_stats().wakeups, 2);
+    EXPECT_EQ(uart_isrpipe->get_stats().bytes, 68);
+
+    scheduler.run();
+
+    EXPECT_EQ(uart_isrpipe->read(data, sizeof(data)), 64);
+    EXPECT_EQ(uart_isrpipe->read(data, sizeof(data)), 0);
+
+    scheduler.run();
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] delimiter byte wakes the reader below the threshold
+     * -------------------------------------------------------------------------
+     **/
+
+    uart_isrpipe->set_wakeup_threshold(32);
+    uart_isrpipe->set_wakeup_delimiter('\n');
+
+    EXPECT_EQ(uart_isrpipe->write("ab", 2), 2);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    EXPECT_EQ(uart_isrpipe->write("c\nd", 3), 3);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(uart_isrpipe->get_stats().wakeups, 3);
+
+    scheduler.run();
+
+    EXPECT_EQ(uart_isrpipe->read(data, sizeof(data)), 5);
+    EXPECT_EQ(memcmp(data, "abc\nd", 5), 0);
+    EXPECT_EQ(uart_isrpipe->read(data, sizeof(data)), 0);
+
+    scheduler.run();
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] idle line wakes the reader with a partial message
+     * -------------------------------------------------------------------------
+     **/
+
+    uart_isrpipe->set_wakeup_delimiter(-1);
+    uart_isrpipe->set_idle_timeout(100);
+
+    EXPECT_EQ(uart_isrpipe->write_one('x'), 0);
+
+    test_helper_ztimer_advance(60);
+
+    EXPECT_EQ(uart_isrpipe->write_one('y'), 0);
+
+    test_helper_ztimer_advance(60);
+
+    /* the second byte restarted the idle time */
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    test_helper_ztimer_advance(40);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_PENDING);
+    EXPECT_EQ(uart_isrpipe->get_stats().wakeups, 4);
+    EXPECT_EQ(uart_isrpipe->get_stats().bytes, 75);
+    EXPECT_EQ(uart_isrpipe->get_stats().dropped, 0);
+
+    scheduler.run();
+
+    EXPECT_EQ(uart_isrpipe->read(data, sizeof(data)), 2);
+
+    uart_isrpipe->set_idle_timeout(0);
+    uart_isrpipe->reset_stats();
+
+    EXPECT_EQ(uart_isrpipe->get_stats().bytes, 0);
+}
+
+TEST_F(TestUtilsUartIsrpipe, read_timeout_test)
+{
+    char idle_stack[128];
+    char reader_stack[128];
+
+    test_helper_ztimer_reset();
+
+    Thread::init(*instance, idle_stack, sizeof(idle_stack), 15,
+                 THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                 NULL, NULL, "idle");
+
+    Thread *reader = Thread::init(*instance, reader_stack, sizeof(reader_stack), 5,
+                                  THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                  NULL, NULL, "reader");
+
+    ThreadScheduler &scheduler = instance->get<ThreadScheduler>();
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), reader);
+
+    char data[8];
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] buffered bytes are returned right away
+     * -------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(uart_isrpipe->write("abc", 3), 3);
+
+    EXPECT_EQ(uart_isrpipe->read_timeout(data, sizeof(data), 100), 3);
+    EXPECT_EQ(memcmp(data, "abc", 3), 0);
+
+    EXPECT_EQ(uart_isrpipe->write("defgh", 5), 5);
+
+    EXPECT_EQ(uart_isrpipe->read_exact(data, 4, 100), 4);
+    EXPECT_EQ(memcmp(data, "defg", 4), 0);
+
+    EXPECT_EQ(uart_isrpipe->read_exact(data, 1, 100), 1);
+    EXPECT_EQ(data[0], 'h');
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] empty pipe blocks the reader until the timeout
+     * -------------------------------------------------------------------------
+     **/
+
+    uint32_t wakeups = uart_isrpipe->get_stats().wakeups;
+
+    uart_isrpipe->read_timeout(data, sizeof(data), 100);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    scheduler.run();
+
+    test_helper_ztimer_advance(99);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    test_helper_ztimer_advance(1);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_PENDING);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), reader);
+
+    /* woken up by the read timer, not by a writer */
+
+    EXPECT_EQ(uart_isrpipe->get_stats().wakeups, wakeups);
+    EXPECT_TRUE(uart_isrpipe->get_tsrb().is_empty());
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] partial data keeps read_exact waiting, a writer wakes it
+     * -------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(uart_isrpipe->write("12", 2), 2);
+
+    uart_isrpipe->read_exact(data, 4, 100);
+
+    EXPECT_EQ(memcmp(data, "12", 2), 0);
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    scheduler.run();
+
+    test_helper_ztimer_advance(50);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    EXPECT_EQ(uart_isrpipe->write("34", 2), 2);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_PENDING);
+
+    scheduler.run();
+
+    EXPECT_EQ(uart_isrpipe->read_exact(data + 2, 2, 100), 2);
+    EXPECT_EQ(memcmp(data, "1234", 4), 0);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] read_exact keeps what it got once the time ran out
+     * -------------------------------------------------------------------------
+     **/
+
+    EXPECT_EQ(uart_isrpipe->write("5", 1), 1);
+
+    /* Note: a new read restarts the read timer */
+
+    uart_isrpipe->read_exact(data, 3, 100);
+
+    EXPECT_EQ(data[0], '5');
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    scheduler.run();
+
+    test_helper_ztimer_advance(99);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    test_helper_ztimer_advance(1);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_PENDING);
+
+    scheduler.run();
+
+    EXPECT_EQ(scheduler.get_current_active_thread(), reader);
+
+    /**
+     * -------------------------------------------------------------------------
+     * [TEST CASE] timeout of 0 waits for a writer only
+     * -------------------------------------------------------------------------
+     **/
+
+    uart_isrpipe->read_exact(data, 2, 0);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    scheduler.run();
+
+    test_helper_ztimer_advance(1000000);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_MUTEX_BLOCKED);
+
+    EXPECT_EQ(uart_isrpipe->write("67", 2), 2);
+
+    EXPECT_EQ(reader->get_status(), THREAD_STATUS_PENDING);
+
+    scheduler.run();
+
+    EXPECT_EQ(uart_isrpipe->read_exact(data, 2, 0), 2);
+    EXPECT_EQ(memcmp(data, "67", 2), 0);
+}
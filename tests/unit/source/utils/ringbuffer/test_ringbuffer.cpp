@@ -130,3 +130,63 @@ TEST_F(TestUtilsRingbuffer, functions_test)
     EXPECT_EQ(rb->free(), 8);
     EXPECT_EQ(rb->avail(), 0);
 }
+
+TEST_F(TestUtilsRingbuffer, zero_copy_test)
+{
+    RingSpan span;
+
+    /* empty buffer, the whole storage is one region */
+
+    EXPECT_EQ(rb->write_reserve(&span), 8);
+    EXPECT_EQ(span.data[0], buffer);
+    EXPECT_EQ(span.size[0], 8);
+    EXPECT_EQ(span.size[1], 0);
+
+    EXPECT_EQ(rb->read_peek(&span), 0);
+
+    memcpy(buffer, "abcdef", 6);
+
+    rb->write_commit(6);
+
+    EXPECT_EQ(rb->avail(), 6);
+
+    EXPECT_EQ(rb->read_peek(&span), 6);
+    EXPECT_EQ(span.data[0], buffer);
+    EXPECT_EQ(span.size[0], 6);
+    EXPECT_EQ(span.size[1], 0);
+
+    EXPECT_EQ(rb->read_release(4), 4);
+
+    EXPECT_EQ(rb->get_one(), 'e');
+
+    /* free storage wraps around the end */
+
+    EXPECT_EQ(rb->write_reserve(&span), 7);
+    EXPECT_EQ(span.data[0], buffer + 6);
+    EXPECT_EQ(span.size[0], 2);
+    EXPECT_EQ(span.data[1], buffer);
+    EXPECT_EQ(span.size[1], 5);
+
+    memcpy(span.data[0], "gh", 2);
+    memcpy(span.data[1], "ij", 2);
+
+    rb->write_commit(4);
+
+    EXPECT_EQ(rb->avail(), 5);
+
+    EXPECT_EQ(rb->read_peek(&span), 5);
+    EXPECT_EQ(span.data[0], buffer + 5);
+    EXPECT_EQ(span.size[0], 3);
+    EXPECT_EQ(span.data[1], buffer);
+    EXPECT_EQ(span.size[1], 2);
+
+    EXPECT_EQ(memcmp(span.data[0], "fgh", 3), 0);
+    EXPECT_EQ(memcmp(span.data[1], "ij", 2), 0);
+
+    /* releasing up to the buffer end continues at the start */
+
+    EXPECT_EQ(rb->read_release(3), 3);
+    EXPECT_EQ(rb->get_one(), 'i');
+    EXPECT_EQ(rb->get_one(), 'j');
+    EXPECT_TRUE(rb->is_empty());
+}
@@ -2,6 +2,7 @@ set(unittest-includes ${unittest-includes}
 )
 
 set(unittest-sources
+    ../../source/core/assert_failure.c
     ../../source/utils/ringbuffer.cpp
 )
 
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#include <string.h>
+
+#include <vcrtos/ztimer.h>
+
+#include "test-helper.h"
+
+static uint32_t ztimer_stub_now;
+static uint32_t ztimer_stub_target;
+static int ztimer_stub_armed;
+
+static void _ztimer_stub_set(ztimer_clock_t *clock, uint32_t val)
+{
+    (void) clock;
+    ztimer_stub_target = ztimer_stub_now + val;
+    ztimer_stub_armed = 1;
+}
+
+static uint32_t _ztimer_stub_now(ztimer_clock_t *clock)
+{
+    (void) clock;
+    return ztimer_stub_now;
+}
+
+static void _ztimer_stub_cancel(ztimer_clock_t *clock)
+{
+    (void) clock;
+    ztimer_stub_armed = 0;
+}
+
+static const ztimer_ops_t ztimer_stub_ops = {
+    .set = _ztimer_stub_set,
+    .now = _ztimer_stub_now,
+    .cancel = _ztimer_stub_cancel,
+};
+
+static ztimer_clock_t ztimer_stub_clock = {
+    .ops = &ztimer_stub_ops,
+};
+
+ztimer_clock_t *const ZTIMER_USEC = &ztimer_stub_clock;
+
+void test_helper_ztimer_reset(void)
+{
+    memset(&ztimer_stub_clock, 0, sizeof(ztimer_stub_clock));
+    ztimer_stub_clock.ops = &ztimer_stub_ops;
+    ztimer_stub_now = 0;
+    ztimer_stub_target = 0;
+    ztimer_stub_armed = 0;
+}
+
+uint32_t test_helper_ztimer_now(void)
+{
+    return ztimer_stub_now;
+}
+
+void test_helper_ztimer_advance(uint32_t us)
+{
+    uint32_t end = ztimer_stub_now + us;
+
+    /* fire every expired timer in ISR context, in order of expiration */
+
+    while (ztimer_stub_armed && (int32_t)(ztimer_stub_target - end) <= 0)
+    {
+        ztimer_stub_now = ztimer_stub_target;
+        ztimer_stub_armed = 0;
+
+        test_helper_set_cpu_in_isr();
+        ztimer_handler(&ztimer_stub_clock);
+        test_helper_reset_cpu_in_isr();
+    }
+
+    ztimer_stub_now = end;
+}
@@ -34,6 +34,12 @@ int test_helper_is_pendsv_interrupt_triggered(void);
 
 void test_helper_reset_pendsv_trigger(void);
 
+void test_helper_ztimer_reset(void);
+
+uint32_t test_helper_ztimer_now(void);
+
+void test_helper_ztimer_advance(uint32_t us);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2020, Vertexcom Technologies, Inc.
+ * All rights reserved.
+ *
+ * NOTICE: All information contained herein is, and remains
+ * the property of Vertexcom Technologies, Inc. and its suppliers,
+ * if any. The intellectual and technical concepts contained
+ * herein are proprietary to Vertexcom Technologies, Inc.
+ * and may be covered by U.S. and Foreign Patents, patents in process,
+ * and protected by trade secret or copyright law.
+ * Dissemination of this information or reproduction of this material
+ * is strictly forbidden unless prior written permission is obtained
+ * from Vertexcom Technologies, Inc.
+ *
+ * Authors: Darko Pancev <darko.pancev@vertexcom.com>
+ */
+
+#ifndef TEST_THREADS_HPP
+#define TEST_THREADS_HPP
+
+/* unit test fixture with an instance running idle (15), main (7) and up to
+ * three tasks, task1 (5), task2 (4) and task3 (6) */
+
+#include "gtest/gtest.h"
+
+#include "core/instance.hpp"
+#include "core/thread.hpp"
+
+#include "test-helper.h"
+
+class TestThreads : public testing::Test
+{
+protected:
+    vc::Instance *instance;
+
+    char idle_stack[128];
+    char main_stack[128];
+    char task1_stack[128];
+    char task2_stack[128];
+    char task3_stack[128];
+
+    vc::Thread *idle_thread;
+    vc::Thread *main_thread;
+    vc::Thread *task1_thread;
+    vc::Thread *task2_thread;
+    vc::Thread *task3_thread;
+
+    explicit TestThreads(unsigned int tasks = 3)
+        : numof_tasks(tasks)
+    {
+    }
+
+    virtual void SetUp()
+    {
+        instance = new vc::Instance();
+
+        test_helper_ztimer_reset();
+
+        idle_thread = create_thread(idle_stack, 15, "idle");
+        main_thread = create_thread(main_stack, 7, "main");
+        task1_thread = (numof_tasks > 0) ? create_thread(task1_stack, 5, "task1") : NULL;
+        task2_thread = (numof_tasks > 1) ? create_thread(task2_stack, 4, "task2") : NULL;
+        task3_thread = (numof_tasks > 2) ? create_thread(task3_stack, 6, "task3") : NULL;
+    }
+
+    virtual void TearDown()
+    {
+        delete instance;
+    }
+
+    vc::Thread *create_thread(char (&stack)[128], uint8_t priority, const char *name)
+    {
+        return vc::Thread::init(*instance, stack, sizeof(stack), priority,
+                                THREAD_FLAGS_CREATE_WOUT_YIELD | THREAD_FLAGS_CREATE_STACKMARKER,
+                                NULL, NULL, name);
+    }
+
+    void sleep_and_run(vc::Thread *thread)
+    {
+        EXPECT_EQ(instance->get<vc::ThreadScheduler>().get_current_active_thread(), thread);
+
+        instance->get<vc::ThreadScheduler>().sleeping_current_thread();
+        instance->get<vc::ThreadScheduler>().run();
+    }
+
+    void wakeup_and_run(vc::Thread *thread)
+    {
+        instance->get<vc::ThreadScheduler>().wakeup_thread(thread->get_pid());
+        instance->get<vc::ThreadScheduler>().run();
+
+        EXPECT_EQ(instance->get<vc::ThreadScheduler>().get_current_active_thread(), thread);
+    }
+
+private:
+    unsigned int numof_tasks;
+};
+
+#endif /* TEST_THREADS_HPP */
@@ -18,9 +18,38 @@
 #ifndef VCRTOS_UNITTEST_CONFIG_H
 #define VCRTOS_UNITTEST_CONFIG_H
 
+/* Note: suites setting unittest-definitions to VCRTOS_UNITTEST_SINGLE_INSTANCE
+ * run on the single instance, e.g. to go through cpu_end_of_isr() */
+#ifndef VCRTOS_UNITTEST_SINGLE_INSTANCE
 #define VCRTOS_CONFIG_MULTIPLE_INSTANCE_ENABLE 1
+#endif
 
 #define VCRTOS_CONFIG_THREAD_FLAGS_ENABLE 1
 #define VCRTOS_CONFIG_THREAD_EVENT_ENABLE 1
+#define VCRTOS_CONFIG_THREAD_EVENT_STATS_ENABLE 1
+
+#define VCRTOS_CONFIG_WORK_QUEUE_ENABLE 1
+
+#define VCRTOS_CONFIG_MSG_INLINE_PAYLOAD_SIZE 16
+
+#define VCRTOS_CONFIG_MSG_PRIORITY_QUEUE_ENABLE 1
+
+#define VCRTOS_CONFIG_MSG_QUEUE_POLICY_ENABLE 1
+
+#define VCRTOS_CONFIG_MSG_QUEUE_STATS_ENABLE 1
+
+#define VCRTOS_CONFIG_MSG_TIMESTAMP_ENABLE 1
+
+#define VCRTOS_CONFIG_MSG_ASYNC_ENABLE 1
+
+#define VCRTOS_CONFIG_MSG_REQUEST_CHECK_ENABLE 1
+
+#define VCRTOS_CONFIG_MSG_PRIORITY_INHERITANCE_ENABLE 1
+
+#define VCRTOS_CONFIG_MSG_FILTER_ENABLE 1
+
+#define VCRTOS_CONFIG_MSG_ISR_QUEUE_ENABLE 1
+
+#define VCRTOS_CONFIG_MSG_BUF_DEBUG 1
 
 #endif /* VCRTOS_UNITTEST_CONFIG_H */